@@ -0,0 +1,77 @@
+/*
+ * test.h
+ *
+ *  Created on: 2026-10-17
+ *
+ * Shared by the test_*.cpp programs: CHECK() reports a condition that does
+ * not hold and testResult() gives the exit status, so that "make test" in
+ * demo/ or ctest can run them all.
+ */
+
+#ifndef TEST_H_INCLUDE_MINI_JSONCPP_
+#define TEST_H_INCLUDE_MINI_JSONCPP_
+
+#include "json.h"
+#include <cstdio>
+#include <string>
+
+static int testFailures = 0;
+
+#define CHECK(condition) do { if (!(condition)) { printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); ++testFailures; } } while (0)
+
+static inline int testResult(const char* name) {
+	printf("%s: %s\n", name, testFailures == 0 ? "ok" : "FAILED");
+	return testFailures == 0 ? 0 : 1;
+}
+
+/// Documents for the tests comparing another way of reading them with
+/// Reader::parse(): every kind of value, escapes, deep and wide nesting.
+static const char* const testDocuments[] = {
+	"{}",
+	"[]",
+	"[0,-0,1,-1,2147483647,-2147483648,4294967296,18446744073709551615,-9223372036854775808]",
+	"[0.5,-1.25e-3,1e308,4.9e-324,123456789012345678901234567890,3.141592653589793]",
+	"{\"t\":true,\"f\":false,\"n\":null,\"s\":\"\",\"a\":[],\"o\":{}}",
+	"{\"escapes\":\"\\\"\\\\\\/\\b\\f\\n\\r\\t\",\"unicode\":\"\\u00e9\\u4e2d\\ud83d\\ude00\"}",
+	"{\"utf8\":\"h\xc3\xa9llo \xe4\xb8\xad\xf0\x9f\x98\x80\"}",
+	"  [ {\"a\" : [ 1 , { \"b\" : [ [ ] , { } , null ] } ] } , \"x\" ]\n",
+	"[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[1]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]",
+	"{\"id\":\"u000001\",\"name\":\"a name long enough to need the heap\",\"tags\":[\"a\",\"b\"],\"score\":12.5,\"nested\":{\"k1\":1,\"k2\":2,\"k3\":3,\"k4\":4,\"k5\":5,\"k6\":6,\"k7\":7,\"k8\":8,\"k9\":9,\"k10\":10}}",
+	"[{\"id\":1,\"v\":\"one\"},{\"id\":2,\"v\":\"two\"},{\"id\":3,\"v\":[1,2,3]},{\"id\":4,\"v\":{\"x\":null}}]",
+	"{\"dup\":1,\"dup\":2}",
+};
+
+static const size_t testDocumentCount = sizeof(testDocuments)
+		/ sizeof(testDocuments[0]);
+
+/// Documents that Reader::parse() rejects.
+static const char* const testMalformed[] = {
+	"",
+	"42",
+	"[1,2",
+	"{\"a\":[}",
+	"{\"a\" 1}",
+	"{\"a\":1,,}",
+	"[\"unterminated]",
+	"{\"a\":tru}",
+	"[1 2]",
+	"[1}",
+};
+
+static const size_t testMalformedCount = sizeof(testMalformed)
+		/ sizeof(testMalformed[0]);
+
+/// \c document parsed by Reader::parse, the reference of the other ways
+/// of reading it.
+static inline bool parseReference(const std::string& document,
+		Json::Value& root) {
+	Json::Reader reader;
+	return reader.parse(document, root);
+}
+
+static inline std::string writeJson(const Json::Value& value) {
+	Json::FastWriter writer;
+	return writer.write(value);
+}
+
+#endif /* TEST_H_INCLUDE_MINI_JSONCPP_ */
@@ -0,0 +1,195 @@
+/*
+ * test_bind.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Structs bound with JSON_BIND() against the Value tree of the same
+ * document: BindReader must read what Reader::parse() reads, BindWriter
+ * must write what FastWriter writes, and type and range errors fail.
+ */
+
+#include "test.h"
+#include <cstdint>
+
+namespace test {
+
+struct Point {
+	int x;
+	int y;
+};
+JSON_BIND(Point, x, y)
+
+struct Record {
+	std::string id;
+	std::string name;
+	std::vector<std::string> tags;
+	double score;
+	std::map<std::string, int> nested;
+	bool active;
+	Json::Int64 big;
+	Json::UInt64 huge;
+	std::vector<Point> points;
+	Json::Value extra;
+	int8_t small;
+	uint16_t port;
+};
+JSON_BIND(Record, id, name, tags, score, nested, active, big, huge, points,
+		extra, small, port)
+
+} // namespace test
+
+using namespace Json;
+
+static const char* const recordText =
+		"{\"id\":\"u000001\",\"name\":\"a name long \\\"escaped\\\" \\u00e9\","
+		"\"tags\":[\"a\",\"b\"],\"score\":12.5,\"ignored\":{\"deep\":[1,[2,{\"x\":3}]]},"
+		"\"nested\":{\"k1\":1,\"k2\":-2},\"active\":true,"
+		"\"big\":-9223372036854775808,\"huge\":18446744073709551615,"
+		"\"points\":[{\"x\":1,\"y\":2},{\"y\":4,\"x\":3,\"z\":5}],"
+		"\"extra\":{\"any\":[null,1.5,\"s\"]},\"small\":-128,\"port\":65535}";
+
+/// Every field against the member of the same name in \c value.
+static void checkRecord(const test::Record& record, const Value& value) {
+	CHECK(record.id == value["id"].asString());
+	CHECK(record.name == value["name"].asString());
+	CHECK(record.tags.size() == value["tags"].size());
+	for (ArrayIndex i = 0; i < record.tags.size(); ++i) {
+		CHECK(record.tags[i] == value["tags"][i].asString());
+	}
+	CHECK(record.score == value["score"].asDouble());
+	CHECK(record.nested.size() == value["nested"].size());
+	CHECK(record.nested.at("k2") == value["nested"]["k2"].asInt());
+	CHECK(record.active == value["active"].asBool());
+	CHECK(record.big == value["big"].asInt64());
+	CHECK(record.huge == value["huge"].asUInt64());
+	CHECK(record.points.size() == value["points"].size());
+	for (ArrayIndex i = 0; i < record.points.size(); ++i) {
+		CHECK(record.points[i].x == value["points"][i]["x"].asInt());
+		CHECK(record.points[i].y == value["points"][i]["y"].asInt());
+	}
+	CHECK(record.extra == value["extra"]);
+	CHECK(record.small == value["small"].asInt());
+	CHECK(record.port == value["port"].asUInt());
+}
+
+static void testRead() {
+	Value expected;
+	CHECK(parseReference(recordText, expected));
+	test::Record record;
+	BindReader reader;
+	CHECK(reader.parse(recordText, record));
+	CHECK(reader.good());
+	checkRecord(record, expected);
+
+	// Fields without a member keep their value.
+	test::Point point = { 7, 8 };
+	CHECK(reader.parse("{\"y\":1,\"other\":[]}", point));
+	CHECK(point.x == 7 && point.y == 1);
+
+	int answer = 0;
+	CHECK(reader.parse(" 42 ", answer));
+	CHECK(answer == 42);
+}
+
+/// Written documents read back as the struct and the Value they came from.
+static void testWrite() {
+	test::Record record;
+	BindReader reader;
+	CHECK(reader.parse(recordText, record));
+
+	std::string written;
+	BindWriter writer(written);
+	writer.write(record);
+	Value reread;
+	CHECK(parseReference(written, reread));
+	checkRecord(record, reread);
+
+	// Without the members no field holds, what FastWriter writes.
+	Value expected;
+	CHECK(parseReference(recordText, expected));
+	expected.removeMember("ignored");
+	expected["points"][1u].removeMember("z");
+	std::string fast = writeJson(expected);
+	Value fromFast;
+	CHECK(parseReference(fast, fromFast));
+	CHECK(fromFast == reread);
+
+	std::vector<test::Point> points(2);
+	points[0].x = -1;
+	points[0].y = 0;
+	points[1].x = 2147483647;
+	points[1].y = -2147483647 - 1;
+	std::string array;
+	BindWriter arrayWriter(array);
+	arrayWriter.write(points);
+	CHECK(array == "[{\"x\":-1,\"y\":0},{\"x\":2147483647,\"y\":-2147483648}]");
+}
+
+static void testErrors() {
+	const char* const wrong[] = {
+		"{\"x\":\"1\"}",
+		"{\"x\":1.5}",
+		"{\"x\":2147483648}",
+		"{\"x\":null,\"y\":[]}",
+		"[1,2]",
+		"{\"x\":1,\"y\":2",
+		"{\"x\":1,\"y\":2,}x",
+	};
+	for (size_t i = 0; i < sizeof(wrong) / sizeof(wrong[0]); ++i) {
+		test::Point point;
+		BindReader reader;
+		CHECK(!reader.parse(wrong[i], point));
+		CHECK(!reader.good());
+		CHECK(!reader.getFormattedErrorMessages().empty());
+	}
+	const char* const outOfRange[] = { "{\"small\":128}", "{\"small\":-129}",
+			"{\"port\":65536}", "{\"port\":-1}", "{\"huge\":-1}",
+			"{\"huge\":18446744073709551616}", "{\"active\":1}",
+			"{\"tags\":[1]}", "{\"nested\":{\"a\":\"b\"}}" };
+	for (size_t i = 0; i < sizeof(outOfRange) / sizeof(outOfRange[0]); ++i) {
+		test::Record record;
+		BindReader reader;
+		CHECK(!reader.parse(outOfRange[i], record));
+	}
+	// Errors outlive the document, here a temporary.
+	test::Point point;
+	BindReader reader;
+	CHECK(!reader.parse(std::string("{\"x\":1,\"y\":true}"), point));
+	CHECK(reader.getFormattedErrorMessages().find("Line 1, Column 12")
+			!= std::string::npos);
+
+	// Malformed documents; a scalar root is fine for a scalar type.
+	for (size_t i = 0; i < testMalformedCount; ++i) {
+		if (std::string(testMalformed[i]) == "42") {
+			continue;
+		}
+		Value value;
+		BindReader reader;
+		CHECK(!reader.parse(testMalformed[i], value));
+	}
+}
+
+/// Value fields read as Reader::parse() reads them.
+static void testValues() {
+	for (size_t i = 0; i < testDocumentCount; ++i) {
+		Value expected;
+		CHECK(parseReference(testDocuments[i], expected));
+		Value value;
+		BindReader reader;
+		CHECK(reader.parse(testDocuments[i], value));
+		CHECK(value == expected);
+
+		std::string written;
+		BindWriter writer(written);
+		writer.write(value);
+		CHECK(written + "\n" == writeJson(expected));
+	}
+}
+
+int main() {
+	testRead();
+	testWrite();
+	testErrors();
+	testValues();
+	return testResult("test_bind");
+}
@@ -0,0 +1,68 @@
+/*
+ * test_borrowed.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Reader::parse() of a borrowed buffer against the parse of a copy, on
+ * buffers that are not NUL terminated and are changed once the parse is
+ * done.
+ */
+
+#include "test.h"
+
+using namespace Json;
+
+/// A copy of \c text in a buffer of exactly its size.
+static std::vector<char> buffer(const std::string& text) {
+	return std::vector<char>(text.begin(), text.end());
+}
+
+static void testAgainstParse() {
+	for (size_t i = 0; i < testDocumentCount; ++i) {
+		Value expected;
+		CHECK(parseReference(testDocuments[i], expected));
+		std::vector<char> bytes = buffer(testDocuments[i]);
+		Reader reader;
+		Value root;
+		CHECK(reader.parse(bytes.data(), bytes.data() + bytes.size(), root));
+		CHECK(root == expected);
+
+		// The tree owns its strings: the buffer may go once parsed.
+		std::fill(bytes.begin(), bytes.end(), 'x');
+		CHECK(root == expected);
+	}
+}
+
+static void testErrors() {
+	for (size_t i = 0; i < testMalformedCount; ++i) {
+		Reader reference;
+		Value expected;
+		CHECK(!reference.parse(testMalformed[i], expected));
+
+		std::vector<char> bytes = buffer(testMalformed[i]);
+		Reader reader;
+		Value root;
+		CHECK(!reader.parse(bytes.data(), bytes.data() + bytes.size(), root));
+		CHECK(reader.getFormattedErrorMessages()
+				== reference.getFormattedErrorMessages());
+	}
+}
+
+/// A document ending at the end of the buffer, with no NUL after it.
+static void testUnterminatedBuffer() {
+	const char text[] = { '[', '1', ',', '2', '3', ']' };
+	Reader reader;
+	Value root;
+	CHECK(reader.parse(text, text + sizeof(text), root));
+	CHECK(root.size() == 2 && root[1u].asInt() == 23);
+
+	// Cut short, a number at the very end of the bytes.
+	CHECK(!reader.parse(text, text + 5, root));
+}
+
+int main() {
+	testAgainstParse();
+	testErrors();
+	testUnterminatedBuffer();
+	return testResult("test_borrowed");
+}
@@ -0,0 +1,132 @@
+/*
+ * test_depth.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * The nesting limit of Reader, in every kind of parse, and documents
+ * nested far deeper than the native stack would allow recursing.
+ */
+
+#include "test.h"
+#include <algorithm>
+
+using namespace Json;
+
+/// Arrays and objects alternately, \c depth containers deep.
+static std::string nested(size_t depth) {
+	std::string open;
+	std::string close;
+	for (size_t i = 0; i < depth; ++i) {
+		if (i % 2 == 0) {
+			open += "[";
+			close += "]";
+		} else {
+			open += "{\"k\":";
+			close += "}";
+		}
+	}
+	return open + "1" + std::string(close.rbegin(), close.rend());
+}
+
+/// Counts how deeply the events nest.
+class DepthCounter: public Handler {
+public:
+	DepthCounter() :
+			depth_(0), deepest_(0) {
+	}
+
+	virtual bool startObject() {
+		return open();
+	}
+	virtual bool endObject() {
+		--depth_;
+		return true;
+	}
+	virtual bool startArray() {
+		return open();
+	}
+	virtual bool endArray() {
+		--depth_;
+		return true;
+	}
+
+	size_t depth_;
+	size_t deepest_;
+
+private:
+	bool open() {
+		deepest_ = std::max(deepest_, ++depth_);
+		return true;
+	}
+};
+
+static bool exceeded(const Reader& reader) {
+	return reader.getFormattedErrorMessages().find("nesting limit")
+			!= std::string::npos;
+}
+
+static void testLimit() {
+	Reader reader;
+	CHECK(reader.stackLimit() == 1000);
+	Value root;
+	CHECK(reader.parse(nested(1000), root));
+	CHECK(!reader.parse(nested(1001), root));
+	CHECK(exceeded(reader));
+
+	unsigned int limits[] = { 1, 2, 3, 10, 64 };
+	for (size_t l = 0; l < sizeof(limits) / sizeof(limits[0]); ++l) {
+		unsigned int limit = limits[l];
+		reader.setStackLimit(limit);
+		CHECK(reader.stackLimit() == limit);
+		std::string fits = nested(limit);
+		std::string deeper = nested(limit + 1);
+		// One more container than the limit fails, wherever it is.
+		std::string wide = "[" + nested(limit - 1) + "," + deeper.substr(1);
+
+		CHECK(reader.parse(fits, root));
+		Value expected;
+		CHECK(parseReference(fits, expected));
+		CHECK(root == expected);
+		CHECK(!reader.parse(deeper, root));
+		CHECK(exceeded(reader));
+		CHECK(!reader.parse(wide, root));
+		CHECK(exceeded(reader));
+
+		CHECK(reader.parse(fits.data(), fits.data() + fits.size(), root));
+		CHECK(!reader.parse(deeper.data(), deeper.data() + deeper.size(), root));
+		CHECK(reader.parseParallel(fits.data(), fits.data() + fits.size(), root, 2));
+		CHECK(!reader.parseParallel(deeper.data(), deeper.data() + deeper.size(),
+				root, 2));
+		CHECK(exceeded(reader));
+
+		ValueBuilder builder(root);
+		CHECK(reader.parse(fits, builder));
+		ValueBuilder deeperBuilder(root);
+		CHECK(!reader.parse(deeper, deeperBuilder));
+		CHECK(exceeded(reader));
+	}
+}
+
+/// Far past the default limit, nesting only costs the heap.
+static void testDeep() {
+	Reader reader;
+	size_t depth = 200000;
+	reader.setStackLimit(depth);
+	std::string document = nested(depth);
+	DepthCounter counter;
+	CHECK(reader.parse(document, counter));
+	CHECK(counter.deepest_ == depth);
+
+	// Errors deep down unwind every open container.
+	std::string broken = document;
+	broken[depth + 2] = ',';
+	DepthCounter brokenCounter;
+	CHECK(!reader.parse(broken, brokenCounter));
+	CHECK(!reader.getFormattedErrorMessages().empty());
+}
+
+int main() {
+	testLimit();
+	testDeep();
+	return testResult("test_depth");
+}
@@ -0,0 +1,87 @@
+/*
+ * test_document.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Documents parsed into an Arena against Reader::parse() into a Value,
+ * copies out of a document, and the Arena itself.
+ */
+
+#include "test.h"
+
+using namespace Json;
+
+static void testAgainstParse() {
+	Document document;
+	for (size_t i = 0; i < testDocumentCount; ++i) {
+		Value expected;
+		CHECK(parseReference(testDocuments[i], expected));
+		Reader reader;
+		// The same document is read again and again, replacing the tree.
+		CHECK(reader.parse(std::string(testDocuments[i]), document));
+		CHECK(document.root() == expected);
+		CHECK(writeJson(document.root()) == writeJson(expected));
+	}
+	for (size_t i = 0; i < testMalformedCount; ++i) {
+		Reader reference;
+		Value expected;
+		CHECK(!reference.parse(testMalformed[i], expected));
+		Reader reader;
+		CHECK(!reader.parse(std::string(testMalformed[i]), document));
+		CHECK(reader.getFormattedErrorMessages()
+				== reference.getFormattedErrorMessages());
+	}
+}
+
+/// A copy is a heap tree that outlives the document.
+static void testCopyOut() {
+	std::string text = testDocuments[9];
+	Value expected;
+	CHECK(parseReference(text, expected));
+
+	Value copy;
+	{
+		Document document;
+		Reader reader;
+		CHECK(reader.parse(text, document));
+		CHECK(document.memoryUsed() > 0);
+		copy = document.root()["nested"];
+		Value whole(document.root());
+		document.clear();
+		CHECK(document.memoryUsed() == 0);
+		CHECK(document.root().isNull());
+		CHECK(whole == expected);
+	}
+	CHECK(copy == expected["nested"]);
+	copy["k11"] = 11;
+	CHECK(copy.size() == 11);
+}
+
+static void testArena() {
+	Arena arena;
+	CHECK(arena.used() == 0);
+	char* previous = NULL;
+	for (size_t i = 1; i < 5000; i += 7) {
+		size_t alignment = size_t(1) << (i % 4);
+		char* p = static_cast<char*>(arena.allocate(i, alignment));
+		CHECK(p != NULL);
+		CHECK(reinterpret_cast<size_t>(p) % alignment == 0);
+		memset(p, 'a', i);
+		CHECK(p != previous);
+		previous = p;
+	}
+	CHECK(arena.used() > 0);
+	arena.clear();
+	CHECK(arena.used() == 0);
+	// Larger than any block.
+	void* large = arena.allocate(1 << 22, 8);
+	memset(large, 0, 1 << 22);
+	CHECK(arena.used() >= size_t(1) << 22);
+}
+
+int main() {
+	testAgainstParse();
+	testCopyOut();
+	testArena();
+	return testResult("test_document");
+}
@@ -0,0 +1,122 @@
+/*
+ * test_file.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Reader::parseFile() against Reader::parse() of the same bytes, on mapped
+ * files of every size, a pipe, and files that cannot be read.
+ */
+
+#include "test.h"
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using namespace Json;
+
+/// A temporary file holding \c content, removed when the test ends.
+class TempFile {
+public:
+	explicit TempFile(const std::string& content) {
+		char path[] = "/tmp/test_fileXXXXXX";
+		int fd = mkstemp(path);
+		CHECK(fd >= 0);
+		CHECK(write(fd, content.data(), content.size())
+				== ssize_t(content.size()));
+		close(fd);
+		path_ = path;
+	}
+	~TempFile() {
+		unlink(path_.c_str());
+	}
+
+	std::string path_;
+};
+
+static void checkSame(const std::string& content) {
+	Reader reference;
+	Value expected;
+	bool ok = reference.parse(content, expected);
+
+	TempFile file(content);
+	Reader reader;
+	Value root;
+	CHECK(reader.parseFile(file.path_, root) == ok);
+	CHECK(reader.getFormattedErrorMessages()
+			== reference.getFormattedErrorMessages());
+	if (ok) {
+		CHECK(root == expected);
+	}
+}
+
+static void testAgainstParse() {
+	for (size_t i = 0; i < testDocumentCount; ++i) {
+		checkSame(testDocuments[i]);
+	}
+	for (size_t i = 0; i < testMalformedCount; ++i) {
+		checkSame(testMalformed[i]);
+	}
+	// Documents ending right at, or next to, the end of a page: nothing
+	// past the file may be read.
+	long page = sysconf(_SC_PAGESIZE);
+	for (long size = page - 2; size <= page + 1; ++size) {
+		std::string number(size, '1');
+		checkSame(number);
+		std::string array = "[" + std::string(size - 2, ' ') + "]";
+		checkSame(array);
+		checkSame(array.substr(0, size - 1));
+	}
+}
+
+static void* writeFifo(void* path) {
+	int fd = open(static_cast<const char*>(path), O_WRONLY);
+	std::string document = "[";
+	for (int i = 0; i < 20000; ++i) {
+		document += i == 0 ? "" : ",";
+		document += testDocuments[i % testDocumentCount];
+	}
+	document += "]";
+	ssize_t written = write(fd, document.data(), document.size());
+	(void) written;
+	close(fd);
+	return NULL;
+}
+
+/// Pipes cannot be mapped: they are read instead.
+static void testPipe() {
+	char directory[] = "/tmp/test_fileXXXXXX";
+	CHECK(mkdtemp(directory) != NULL);
+	std::string path = std::string(directory) + "/fifo";
+	CHECK(mkfifo(path.c_str(), 0600) == 0);
+
+	pthread_t writer;
+	pthread_create(&writer, NULL, writeFifo, const_cast<char*>(path.c_str()));
+	Reader reader;
+	Value root;
+	CHECK(reader.parseFile(path, root));
+	pthread_join(writer, NULL);
+	CHECK(root.size() == 20000);
+	Value expected;
+	CHECK(parseReference(testDocuments[9], expected));
+	CHECK(root[9u] == expected);
+
+	unlink(path.c_str());
+	rmdir(directory);
+}
+
+static void testUnreadable() {
+	Reader reader;
+	Value root;
+	CHECK(!reader.parseFile("/nonexistent/test_file.json", root));
+	CHECK(!reader.getFormattedErrorMessages().empty());
+	CHECK(!reader.parseFile("/tmp", root));
+	CHECK(!reader.getFormattedErrorMessages().empty());
+}
+
+int main() {
+	testAgainstParse();
+	testPipe();
+	testUnreadable();
+	return testResult("test_file");
+}
@@ -0,0 +1,130 @@
+/*
+ * test_filter.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Reader::setKeyFilter() against the same members removed from the whole
+ * tree, in every kind of parse, with names denied, allowed, or decided by
+ * an overridden keep().
+ */
+
+#include "test.h"
+
+using namespace Json;
+
+/// Keeps the names of an even length.
+class EvenFilter: public KeyFilter {
+public:
+	virtual bool keep(const std::string& name) const {
+		return name.size() % 2 == 0;
+	}
+};
+
+/// \c value without the members \c filter rejects, at any depth.
+static Value filtered(const Value& value, const KeyFilter& filter) {
+	if (value.isObject()) {
+		Value result(objectValue);
+		Value::Members names = value.getMemberNames();
+		for (size_t i = 0; i < names.size(); ++i) {
+			if (filter.keep(names[i])) {
+				result[names[i]] = filtered(value[names[i]], filter);
+			}
+		}
+		return result;
+	}
+	if (value.isArray()) {
+		Value result(arrayValue);
+		for (ArrayIndex i = 0; i < value.size(); ++i) {
+			result[i] = filtered(value[i], filter);
+		}
+		return result;
+	}
+	return value;
+}
+
+static void checkFilter(const std::string& document, const KeyFilter& filter) {
+	Value whole;
+	CHECK(parseReference(document, whole));
+	Value expected = filtered(whole, filter);
+
+	Reader reader;
+	reader.setKeyFilter(&filter);
+	Value root;
+	CHECK(reader.parse(document, root));
+	CHECK(root == expected);
+	CHECK(reader.parse(document.data(), document.data() + document.size(),
+			root));
+	CHECK(root == expected);
+	CHECK(reader.parseParallel(document.data(),
+			document.data() + document.size(), root, 3));
+	CHECK(root == expected);
+
+	Document parsed;
+	CHECK(reader.parse(document, parsed));
+	CHECK(parsed.root() == expected);
+
+	Value built;
+	ValueBuilder builder(built);
+	CHECK(reader.parse(document, builder));
+	CHECK(built == expected);
+}
+
+static void testAgainstTree() {
+	KeyFilter denied;
+	denied.deny("a");
+	denied.deny("nested");
+	denied.deny("dup");
+	KeyFilter allowed;
+	allowed.allow("id");
+	allowed.allow("nested");
+	allowed.allow("k3");
+	allowed.allow("b");
+	KeyFilter both;
+	both.allow("id");
+	both.allow("v");
+	both.deny("v");
+	EvenFilter even;
+	KeyFilter none;
+	const KeyFilter* filters[] = { &denied, &allowed, &both, &even, &none };
+
+	std::string records = "[";
+	for (size_t i = 0; i < 300; ++i) {
+		records += i == 0 ? "" : ",";
+		records += testDocuments[i % testDocumentCount];
+	}
+	records += "]";
+	for (size_t f = 0; f < sizeof(filters) / sizeof(filters[0]); ++f) {
+		for (size_t i = 0; i < testDocumentCount; ++i) {
+			checkFilter(testDocuments[i], *filters[f]);
+		}
+		checkFilter(records, *filters[f]);
+	}
+}
+
+static void testNames() {
+	KeyFilter filter;
+	CHECK(filter.keep("anything"));
+	filter.deny("x");
+	CHECK(!filter.keep("x") && filter.keep("y"));
+	filter.allow("y");
+	CHECK(filter.keep("y") && !filter.keep("z") && !filter.keep("x"));
+	filter.clear();
+	CHECK(filter.keep("x") && filter.keep("z"));
+
+	// Errors inside a dropped member go unnoticed, others do not.
+	filter.deny("skip");
+	Reader reader;
+	reader.setKeyFilter(&filter);
+	Value root;
+	CHECK(reader.parse("{\"skip\":[1 2],\"keep\":1}", root));
+	CHECK(root.size() == 1 && root["keep"].asInt() == 1);
+	CHECK(!reader.parse("{\"skip\":1,\"keep\":[1 2]}", root));
+	reader.setKeyFilter(NULL);
+	CHECK(!reader.parse("{\"skip\":[1 2],\"keep\":1}", root));
+}
+
+int main() {
+	testAgainstTree();
+	testNames();
+	return testResult("test_filter");
+}
@@ -0,0 +1,116 @@
+/*
+ * test_find.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Member lookups by pointer and length: find(), isMember(), get() and
+ * findOrInsert() in all their forms against operator[], names with NULs
+ * included.
+ */
+
+#include "test.h"
+
+using namespace Json;
+
+static void testForms() {
+	Value object;
+	CHECK(parseReference("{\"id\":1,\"name\":\"x\",\"a name past sixteen bytes\":[2],\"\":3}",
+			object));
+	const Value& constant = object;
+	const char* const names[] = { "id", "name", "a name past sixteen bytes", "",
+			"missing", "i", "ids" };
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+		std::string name = names[i];
+		const char* begin = name.data();
+		const char* end = begin + name.size();
+		bool present = i < 4;
+
+		Value* found = object.find(begin, end);
+		CHECK((found != NULL) == present);
+		CHECK(object.find(name) == found);
+		CHECK(object.find(names[i]) == found);
+		CHECK(constant.find(begin, end) == found);
+		CHECK(constant.find(name) == found);
+		CHECK(object.isMember(begin, end) == present);
+		CHECK(object.isMember(name) == present);
+		CHECK(object.isMember(names[i]) == present);
+		CHECK(constant.get(begin, end, Value("default"))
+				== (present ? *found : Value("default")));
+		CHECK(constant.get(name, Value(-1)) == (present ? *found : Value(-1)));
+		CHECK(constant.get(names[i], Value()) == (present ? *found : Value()));
+		if (present) {
+			CHECK(&object[name] == found);
+			CHECK(&constant[name] == found);
+		}
+#if __cplusplus >= 201703L
+		std::string_view view(name);
+		CHECK(object.find(view) == found);
+		CHECK(object.isMember(view) == present);
+		CHECK(constant.get(view, Value(-1)) == (present ? *found : Value(-1)));
+#endif
+	}
+	// Lookups never add members.
+	CHECK(object.size() == 4);
+}
+
+static void testFindOrInsert() {
+	Value object(objectValue);
+	for (int round = 0; round < 2; ++round) {
+		for (int i = 0; i < 40; ++i) {
+			char name[16];
+			int length = snprintf(name, sizeof(name), "m%d", i);
+			bool inserted = false;
+			Value& member = object.findOrInsert(name, name + length, &inserted);
+			CHECK(inserted == (round == 0));
+			CHECK(&member == object.find(name, name + length));
+			if (round == 0) {
+				CHECK(member.isNull());
+				member = i;
+			} else {
+				CHECK(member.asInt() == i);
+			}
+		}
+	}
+	CHECK(object.size() == 40);
+
+	// On null, as operator[] does, it makes an object.
+	Value empty;
+	const char name[] = "k";
+	empty.findOrInsert(name, name + 1) = 1;
+	CHECK(empty.isObject() && empty["k"].asInt() == 1);
+
+	// Lookups on values that are not objects find nothing.
+	Value array(arrayValue);
+	array.append(1);
+	CHECK(array.find("k") == NULL);
+	CHECK(!array.isMember("k"));
+	CHECK(array.get("k", Value(9)).asInt() == 9);
+	CHECK(Value().find("k") == NULL);
+}
+
+/// The std::string forms use the whole string, NULs included.
+static void testEmbeddedNul() {
+	Value object(objectValue);
+	std::string withNul("a\0b", 3);
+	object[withNul] = 1;
+	object["a"] = 2;
+	CHECK(object.size() == 2);
+	CHECK(object[withNul].asInt() == 1);
+	CHECK(object.find(withNul)->asInt() == 1);
+	CHECK(object.isMember(withNul));
+	CHECK(!object.isMember(std::string("a\0c", 3)));
+	CHECK(object.get(withNul, Value()).asInt() == 1);
+	CHECK(object["a"].asInt() == 2);
+
+	Value parsed;
+	CHECK(parseReference("{\"a\\u0000b\":1,\"a\":2}", parsed));
+	CHECK(parsed.find(withNul) != NULL && parsed[withNul].asInt() == 1);
+	CHECK(parsed == object);
+}
+
+int main() {
+	testForms();
+	testFindOrInsert();
+	testEmbeddedNul();
+	return testResult("test_find");
+}
@@ -0,0 +1,214 @@
+/*
+ * test_gzip.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * GzipReader against Reader::parse() of the uncompressed document: gzip and
+ * zlib input fed split at every byte and in random chunks, concatenated
+ * members, and corrupt or truncated input.
+ */
+
+#include "test.h"
+#include <cstdlib>
+#include <unistd.h>
+#include <zlib.h>
+
+using namespace Json;
+
+static const int gzipFormat = 15 + 16;
+static const int zlibFormat = 15;
+
+/// \c text compressed in the format \c windowBits selects.
+static std::string compress(const std::string& text, int windowBits) {
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	CHECK(deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, windowBits, 8,
+			Z_DEFAULT_STRATEGY) == Z_OK);
+	std::string compressed(deflateBound(&stream, text.size()), '\0');
+	stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(text.data()));
+	stream.avail_in = uInt(text.size());
+	stream.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+	stream.avail_out = uInt(compressed.size());
+	CHECK(deflate(&stream, Z_FINISH) == Z_STREAM_END);
+	compressed.resize(stream.total_out);
+	deflateEnd(&stream);
+	return compressed;
+}
+
+/// Feed \c compressed to a new GzipReader, cut at the offsets in \c cuts.
+static bool gzipParse(const std::string& compressed,
+		const std::vector<size_t>& cuts, Value& root, std::string& errors) {
+	GzipReader reader(root);
+	size_t start = 0;
+	for (size_t i = 0; i <= cuts.size(); ++i) {
+		size_t end = i < cuts.size() ? cuts[i] : compressed.size();
+		std::vector<char> chunk(compressed.begin() + start,
+				compressed.begin() + end);
+		reader.feed(chunk.data(), chunk.size());
+		start = end;
+	}
+	bool ok = reader.finish();
+	errors = reader.getFormattedErrorMessages();
+	return ok;
+}
+
+static void checkSplits(const std::string& text, int windowBits) {
+	Reader reference;
+	Value expected;
+	bool expectedOk = reference.parse(text, expected);
+	std::string expectedErrors = reference.getFormattedErrorMessages();
+	std::string compressed = compress(text, windowBits);
+
+	std::vector<std::vector<size_t> > splits;
+	for (size_t cut = 0; cut <= compressed.size(); ++cut) {
+		splits.push_back(std::vector<size_t>(1, cut));
+	}
+	for (int round = 0; round < 10; ++round) {
+		std::vector<size_t> cuts;
+		for (size_t cut = rand() % 5; cut < compressed.size();
+				cut += 1 + rand() % 7) {
+			cuts.push_back(cut);
+		}
+		splits.push_back(cuts);
+	}
+
+	for (size_t i = 0; i < splits.size(); ++i) {
+		Value root;
+		std::string errors;
+		bool ok = gzipParse(compressed, splits[i], root, errors);
+		CHECK(ok == expectedOk);
+		if (ok) {
+			CHECK(root == expected);
+		} else {
+			CHECK(errors == expectedErrors);
+		}
+	}
+}
+
+static void testAgainstParse() {
+	for (size_t i = 0; i < testDocumentCount; ++i) {
+		checkSplits(testDocuments[i], gzipFormat);
+		checkSplits(testDocuments[i], zlibFormat);
+	}
+	for (size_t i = 0; i < testMalformedCount; ++i) {
+		checkSplits(testMalformed[i], gzipFormat);
+	}
+	// Roots that are not containers, with errors of their own.
+	checkSplits(" : }", gzipFormat);
+	checkSplits("\"\\u07f\":1", gzipFormat);
+}
+
+/// A document far larger than the inflate buffer, fed in random chunks.
+static void testLarge() {
+	std::string text = "[";
+	for (int i = 0; i < 30000; ++i) {
+		text += i == 0 ? "" : ",";
+		text += testDocuments[i % testDocumentCount];
+	}
+	text += "]";
+	Value expected;
+	CHECK(parseReference(text, expected));
+
+	std::string compressed = compress(text, gzipFormat);
+	std::vector<size_t> cuts;
+	for (size_t cut = 0; cut < compressed.size(); cut += 1 + rand() % 5000) {
+		cuts.push_back(cut);
+	}
+	Value root;
+	std::string errors;
+	CHECK(gzipParse(compressed, cuts, root, errors));
+	CHECK(root == expected);
+
+	// Whole, from a file.
+	char path[] = "/tmp/test_gzipXXXXXX";
+	int fd = mkstemp(path);
+	CHECK(write(fd, compressed.data(), compressed.size())
+			== ssize_t(compressed.size()));
+	close(fd);
+	Value fromFile;
+	GzipReader reader(fromFile);
+	CHECK(reader.parseFile(path));
+	CHECK(fromFile == expected);
+	unlink(path);
+	CHECK(!reader.parseFile("/nonexistent/test_gzip.json.gz"));
+}
+
+/// Concatenated gzip members are one stream, as with gzip -d.
+static void testMembers() {
+	std::string compressed = compress("{\"a\":[1,", gzipFormat)
+			+ compress("2],\"b\":", gzipFormat) + compress("true}", gzipFormat);
+	for (size_t cut = 0; cut <= compressed.size(); ++cut) {
+		Value root;
+		std::string errors;
+		CHECK(gzipParse(compressed, std::vector<size_t>(1, cut), root, errors));
+		CHECK(root["a"].size() == 2 && root["b"].asBool());
+	}
+}
+
+static void testCorrupt() {
+	std::string compressed = compress(testDocuments[9], gzipFormat);
+	Value root;
+	std::string errors;
+
+	// Cut short: the document, or the stream, is incomplete.
+	for (size_t size = 0; size < compressed.size(); ++size) {
+		CHECK(!gzipParse(compressed.substr(0, size), std::vector<size_t>(),
+				root, errors));
+		CHECK(!errors.empty());
+	}
+	// Not compressed at all.
+	CHECK(!gzipParse(testDocuments[9], std::vector<size_t>(), root, errors));
+	CHECK(!errors.empty());
+	// A damaged check sum.
+	std::string damaged = compressed;
+	damaged[damaged.size() - 6] ^= 0x55;
+	CHECK(!gzipParse(damaged, std::vector<size_t>(), root, errors));
+
+	// reset() starts again after an error.
+	GzipReader reader(root);
+	reader.feed(damaged);
+	CHECK(!reader.finish());
+	CHECK(!reader.good());
+	reader.reset();
+	CHECK(reader.good());
+	CHECK(reader.feed(compressed));
+	CHECK(reader.finish());
+	Value expected;
+	CHECK(parseReference(testDocuments[9], expected));
+	CHECK(root == expected);
+}
+
+/// Deep input fails at the nesting limit of Reader.
+static void testStackLimit() {
+	std::string deep = compress(std::string(1000000, '[')
+			+ std::string(1000000, ']'), gzipFormat);
+	Value root;
+	GzipReader reader(root);
+	CHECK(reader.stackLimit() == 1000);
+	reader.feed(deep);
+	CHECK(!reader.finish());
+	CHECK(reader.getFormattedErrorMessages().find(
+			"Exceeded the nesting limit of the reader.") != std::string::npos);
+
+	std::string fits = compress(std::string(5, '[') + std::string(5, ']'),
+			gzipFormat);
+	reader.reset();
+	reader.setStackLimit(4);
+	CHECK(reader.stackLimit() == 4);
+	reader.feed(fits);
+	CHECK(!reader.finish());
+	reader.reset();
+	reader.setStackLimit(5);
+	reader.feed(fits);
+	CHECK(reader.finish());
+}
+
+int main() {
+	srand(12);
+	testAgainstParse();
+	testLarge();
+	testMembers();
+	testCorrupt();
+	testStackLimit();
+	return testResult("test_gzip");
+}
@@ -0,0 +1,123 @@
+/*
+ * test_handler.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Reader::parse() with a Handler: ValueBuilder against the Value parse,
+ * the events of a document in order and stopping a parse early.
+ */
+
+#include "test.h"
+#include <sstream>
+
+using namespace Json;
+
+/// Writes the events it receives as one line of text.
+class EventLog: public Handler {
+public:
+	EventLog() :
+			stopAt_(-1) {
+	}
+
+	virtual bool null() {
+		return add("null");
+	}
+	virtual bool boolean(bool value) {
+		return add(value ? "true" : "false");
+	}
+	virtual bool int64(Int64 value) {
+		std::ostringstream text;
+		text << "int:" << value;
+		return add(text.str());
+	}
+	virtual bool uint64(UInt64 value) {
+		std::ostringstream text;
+		text << "uint:" << value;
+		return add(text.str());
+	}
+	virtual bool real(double value) {
+		std::ostringstream text;
+		text << "real:" << value;
+		return add(text.str());
+	}
+	virtual bool string(const char* value, size_t length) {
+		return add("string:" + std::string(value, length));
+	}
+	virtual bool startObject() {
+		return add("{");
+	}
+	virtual bool key(const char* name, size_t length) {
+		return add("key:" + std::string(name, length));
+	}
+	virtual bool endObject() {
+		return add("}");
+	}
+	virtual bool startArray() {
+		return add("[");
+	}
+	virtual bool endArray() {
+		return add("]");
+	}
+
+	std::string events_;
+	/// Number of events after which to stop the parse, -1 for never.
+	int stopAt_;
+
+private:
+	bool add(const std::string& event) {
+		if (!events_.empty()) {
+			events_ += ' ';
+		}
+		events_ += event;
+		return stopAt_ < 0 || stopAt_-- > 0;
+	}
+};
+
+static void testValueBuilder() {
+	for (size_t i = 0; i < testDocumentCount; ++i) {
+		Value expected;
+		CHECK(parseReference(testDocuments[i], expected));
+		Value root;
+		ValueBuilder builder(root);
+		Reader reader;
+		CHECK(reader.parse(testDocuments[i], builder));
+		CHECK(root == expected);
+		CHECK(writeJson(root) == writeJson(expected));
+	}
+	for (size_t i = 0; i < testMalformedCount; ++i) {
+		Value root;
+		ValueBuilder builder(root);
+		Reader reader;
+		CHECK(!reader.parse(testMalformed[i], builder));
+	}
+}
+
+static void testEvents() {
+	EventLog log;
+	Reader reader;
+	CHECK(reader.parse("{\"a\":[1,-2,3.5,\"s\"],\"b\":{\"c\":null,\"d\":true},"
+			"\"e\":18446744073709551615}", log));
+	CHECK(log.events_ == "{ key:a [ int:1 int:-2 real:3.5 string:s ] key:b { "
+			"key:c null key:d true } key:e uint:18446744073709551615 }");
+
+	// Strings are passed with their length, zeroes included.
+	EventLog zero;
+	CHECK(reader.parse("[\"a\\u0000b\"]", zero));
+	CHECK(zero.events_ == std::string("[ string:a\0b ]", 14));
+}
+
+static void testStop() {
+	EventLog log;
+	log.stopAt_ = 3;
+	Reader reader;
+	CHECK(!reader.parse("[1,2,3,4,5]", log));
+	CHECK(log.events_ == "[ int:1 int:2 int:3");
+	CHECK(!reader.good());
+}
+
+int main() {
+	testValueBuilder();
+	testEvents();
+	testStop();
+	return testResult("test_handler");
+}
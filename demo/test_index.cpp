@@ -0,0 +1,227 @@
+/*
+ * test_index.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * StructuralIndex, stage one of Reader::parse(): the index against a byte
+ * at a time reference, window by window and from restarts, and parses of
+ * documents whose strings and escapes straddle the 64 byte blocks of the
+ * scan or the stretches the index is built in.
+ */
+
+#include "test.h"
+#include "lazy.h"
+#include <cstdlib>
+
+using namespace Json;
+
+/// The offsets StructuralIndex records, found one byte at a time.
+static std::vector<StructuralIndex::Offset> reference(const std::string& text) {
+	std::vector<StructuralIndex::Offset> offsets;
+	bool inString = false;
+	bool escaped = false;
+	bool inScalar = false;
+	for (size_t i = 0; i < text.size(); ++i) {
+		char c = text[i];
+		if (inString) {
+			if (escaped) {
+				escaped = false;
+			} else if (c == '\\') {
+				escaped = true;
+			} else if (c == '"') {
+				inString = false;
+				inScalar = false;
+				offsets.push_back(i);
+			}
+			continue;
+		}
+		// Outside strings a backslash only keeps the next quote from
+		// opening a string.
+		bool wasEscaped = escaped;
+		escaped = false;
+		if (c == '"') {
+			if (wasEscaped) {
+				if (!inScalar) {
+					offsets.push_back(i);
+				}
+				inScalar = true;
+			} else {
+				inString = true;
+				offsets.push_back(i);
+			}
+		} else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':'
+				|| c == ',') {
+			inScalar = false;
+			offsets.push_back(i);
+		} else if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+			inScalar = false;
+		} else {
+			if (!inScalar) {
+				offsets.push_back(i);
+			}
+			inScalar = true;
+			escaped = c == '\\' && !wasEscaped;
+		}
+	}
+	return offsets;
+}
+
+static void testAgainstReference() {
+	const char alphabet[] = "ab\\\\\\\"\" {}[]:,\t\n1e-";
+	srand(7);
+	for (int round = 0; round < 20000; ++round) {
+		std::string text;
+		int length = rand() % 300;
+		for (int i = 0; i < length; ++i) {
+			text += alphabet[rand() % (sizeof(alphabet) - 1)];
+		}
+		StructuralIndex index;
+		CHECK(index.build(text.data(), text.data() + text.size()));
+		// Short documents are indexed by build() alone.
+		std::vector<StructuralIndex::Offset> offsets(index.begin(), index.end());
+		CHECK(offsets == reference(text));
+		CHECK(index.next() == NULL);
+	}
+	CHECK(StructuralIndex::implementation() != NULL);
+}
+
+/// Every offset of the document from the current window on, collected as
+/// next() refills the window.
+static std::vector<StructuralIndex::Offset> collect(StructuralIndex& index) {
+	std::vector<StructuralIndex::Offset> offsets(index.begin(), index.end());
+	const StructuralIndex::Offset* added;
+	while ((added = index.next()) != NULL) {
+		CHECK(index.size() <= StructuralIndex::windowEntries);
+		CHECK(index.windowBegin() <= index.windowEnd());
+		offsets.insert(offsets.end(), added, index.end());
+	}
+	return offsets;
+}
+
+static void testWindows() {
+	// Dense enough for the offsets to overflow the window several times.
+	const char alphabet[] = "a\\\"\" {}[]:,\n1";
+	srand(11);
+	std::string text;
+	while (text.size() < 8 * StructuralIndex::windowEntries) {
+		text += alphabet[rand() % (sizeof(alphabet) - 1)];
+	}
+	std::vector<StructuralIndex::Offset> expected = reference(text);
+	CHECK(expected.size() > 2 * StructuralIndex::windowEntries);
+
+	StructuralIndex index;
+	CHECK(index.build(text.data(), text.data() + text.size()));
+	CHECK(index.windowBegin() == 0);
+	CHECK(collect(index) == expected);
+	CHECK(index.windowEnd() == text.size());
+
+	// Restarting on a structural character indexes the rest the same way.
+	for (int i = 0; i < 20; ++i) {
+		size_t first = size_t(rand()) % expected.size();
+		while (strchr("{}[]:,", text[expected[first]]) == NULL) {
+			++first;
+		}
+		index.restart(expected[first]);
+		CHECK(index.windowBegin() == expected[first]);
+		CHECK(collect(index)
+				== std::vector<StructuralIndex::Offset>(
+						expected.begin() + first, expected.end()));
+	}
+
+	StructuralIndex copy(index);
+	index.restart(0);
+	copy = index;
+	CHECK(std::vector<StructuralIndex::Offset>(copy.begin(), copy.end())
+			== std::vector<StructuralIndex::Offset>(index.begin(), index.end()));
+}
+
+/// Documents much larger than a window: Reader reads on as the window is
+/// refilled, LazyDocument seeks back and forth across windows.
+static void testLargeDocuments() {
+	Value expected(arrayValue);
+	for (int i = 0; i < 60000; ++i) {
+		Value& item = expected.append(Value(objectValue));
+		item["id"] = i;
+		item["tags"].append("a \" quoted \\ tag");
+		item["tags"].append(i % 3 == 0);
+		if (i % 1000 == 0) {
+			// Strings longer than the stretches the index is built in.
+			item["long"] = std::string(20000 + i % 64, i % 2 == 0 ? 'x' : '\\');
+		}
+	}
+	std::string text = writeJson(expected);
+	CHECK(text.size() > 4 * StructuralIndex::windowEntries);
+
+	Reader reader;
+	Value root;
+	CHECK(reader.parse(text, root));
+	CHECK(root == expected);
+
+	LazyDocument lazy;
+	CHECK(lazy.parse(text));
+	LazyValue items = lazy.root();
+	srand(5);
+	for (int i = 0; i < 200; ++i) {
+		ArrayIndex at = ArrayIndex(rand() % 60000);
+		CHECK(items[at]["id"].asInt() == int(at));
+		CHECK(items[at]["tags"][0u].asString() == "a \" quoted \\ tag");
+	}
+	CHECK(items[59000u]["long"].asString() == expected[59000u]["long"].asString());
+
+	// An error at the far end is reported where it is.
+	std::string broken = text.substr(0, text.size() - 3) + "@]";
+	char column[64];
+	snprintf(column, sizeof(column), "Line 1, Column %lu\n",
+			(unsigned long) text.size() - 2);
+	CHECK(!reader.parse(broken, root));
+	CHECK(reader.getFormattedErrorMessages().find(column) != std::string::npos);
+}
+
+/// The same document shifted across block boundaries parses the same.
+static void testBlockBoundaries() {
+	std::string body = "{\"s\":\"quote \\\" backslash \\\\\\\\ tab \\t\","
+			"\"n\":[1,-2.5e3,true,false,null],\"\\\\\":\"\\\\\"}";
+	Value expected;
+	CHECK(parseReference(body, expected));
+	CHECK(expected["s"].asString() == "quote \" backslash \\\\ tab \t");
+	CHECK(expected["\\"].asString() == "\\");
+	for (int padding = 0; padding < 140; ++padding) {
+		std::string text = std::string(padding, ' ') + body
+				+ std::string(padding % 7, '\n');
+		Value root;
+		Reader reader;
+		CHECK(reader.parse(text, root));
+		CHECK(root == expected);
+	}
+
+	// A long string of backslash pairs ends on every offset of a block.
+	for (int count = 60; count < 140; ++count) {
+		std::string escapes;
+		for (int i = 0; i < count; ++i) {
+			escapes += "\\\\";
+		}
+		Value root;
+		Reader reader;
+		CHECK(reader.parse("[\"" + escapes + "\",\"x\"]", root));
+		CHECK(root.size() == 2);
+		CHECK(root[0u].asString() == std::string(count, '\\'));
+		CHECK(root[1u].asString() == "x");
+	}
+}
+
+static void testErrorsStillReported() {
+	Reader reader;
+	Value root;
+	CHECK(!reader.parse("{\"a\":[1,2,}", root));
+	CHECK(!reader.getFormattedErrorMessages().empty());
+	CHECK(!reader.parse("[\"unterminated]", root));
+}
+
+int main() {
+	testAgainstReference();
+	testWindows();
+	testLargeDocuments();
+	testBlockBoundaries();
+	testErrorsStillReported();
+	return testResult("test_index");
+}
@@ -0,0 +1,120 @@
+/*
+ * test_keys.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * KeyTable: parses interning their member names against Reader::parse(),
+ * one copy of each name, and a table shared by readers on several threads.
+ */
+
+#include "test.h"
+#include <pthread.h>
+
+using namespace Json;
+
+static void testAgainstParse() {
+	KeyTable table;
+	Reader reader;
+	reader.setKeyTable(&table);
+	std::vector<Value> roots;
+	for (int round = 0; round < 2; ++round) {
+		for (size_t i = 0; i < testDocumentCount; ++i) {
+			Value expected;
+			CHECK(parseReference(testDocuments[i], expected));
+			Value root;
+			CHECK(reader.parse(testDocuments[i], root));
+			CHECK(root == expected);
+			CHECK(writeJson(root) == writeJson(expected));
+			roots.push_back(root);
+		}
+	}
+	// The second round found every name in the table.
+	size_t names = table.size();
+	CHECK(names > 0);
+	for (size_t i = 0; i < testDocumentCount; ++i) {
+		Value root;
+		CHECK(reader.parse(testDocuments[i], root));
+	}
+	CHECK(table.size() == names);
+
+	// Copies share the names and stay valid with the table.
+	for (size_t i = 0; i < roots.size(); ++i) {
+		Value copy(roots[i]);
+		CHECK(copy == roots[i]);
+	}
+
+	reader.setKeyTable(NULL);
+	Value root;
+	CHECK(reader.parse("{\"a name the table never saw\":1}", root));
+	CHECK(table.size() == names);
+}
+
+static void testIntern() {
+	KeyTable table;
+	CHECK(table.size() == 0);
+	std::string names[] = { "", "a", "id", "fifteen bytes..",
+			"a name longer than any inline key", std::string("nul\0inside", 10) };
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+		Key key = table.intern(names[i]);
+		CHECK(std::string(key.data(), key.length()) == names[i]);
+		// The same bytes for every key of the name.
+		CHECK(table.intern(names[i]).data() == key.data());
+		Key copy(key);
+		CHECK(copy.data() == key.data());
+		CHECK(copy == Key(names[i].data(), names[i].size()));
+	}
+	CHECK(table.size() == sizeof(names) / sizeof(names[0]));
+}
+
+struct SharedWork {
+	KeyTable* table_;
+	int thread_;
+	int failures_;
+};
+
+/// Documents whose names partly overlap those of the other threads.
+static void* parseShared(void* argument) {
+	SharedWork& work = *static_cast<SharedWork*>(argument);
+	Reader reader;
+	reader.setKeyTable(work.table_);
+	Reader plain;
+	for (int i = 0; i < 2000; ++i) {
+		char document[128];
+		snprintf(document, sizeof(document),
+				"{\"common\":%d,\"name%d\":[%d],\"thread%d_%d\":{\"common\":1}}", i,
+				i % 100, i, work.thread_, i % 50);
+		Value root;
+		Value expected;
+		if (!reader.parse(document, root) || !plain.parse(document, expected)
+				|| !(root == expected)) {
+			++work.failures_;
+		}
+	}
+	return NULL;
+}
+
+static void testThreads() {
+	KeyTable table;
+	const int threadCount = 4;
+	pthread_t threads[threadCount];
+	SharedWork work[threadCount];
+	for (int t = 0; t < threadCount; ++t) {
+		work[t].table_ = &table;
+		work[t].thread_ = t;
+		work[t].failures_ = 0;
+		pthread_create(&threads[t], NULL, parseShared, &work[t]);
+	}
+	for (int t = 0; t < threadCount; ++t) {
+		pthread_join(threads[t], NULL);
+		CHECK(work[t].failures_ == 0);
+	}
+	// "common", 100 "nameN" and 50 "threadT_N" per thread.
+	CHECK(table.size() == 1 + 100 + 50 * threadCount);
+}
+
+int main() {
+	testAgainstParse();
+	testIntern();
+	testThreads();
+	return testResult("test_keys");
+}
@@ -0,0 +1,125 @@
+/*
+ * test_lazy.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * LazyDocument against Reader::parse(): the same documents must give the
+ * same values, looked up by name or index, iterated or built whole.
+ */
+
+#include "test.h"
+
+using namespace Json;
+
+static const char* documents[] = {
+	"{}",
+	"[]",
+	"[1,-2,3.5,1e300,-0,18446744073709551615,-9223372036854775808]",
+	"{\"a\":{\"b\":[true,false,null,\"x\\\\ny\"]},\"c\":\"\\u00e9\\ud83d\\ude00\"}",
+	"  [ { \"k\" : [ [ ] , { } ] } , \"s\" ]  ",
+	"{\"name\":\"a string long enough to need the heap\",\"n\":12345678901234}",
+	"{\"\\\"escaped\\\"\":1,\"plain\":2}",
+};
+
+/// Build \c value the way the DOM would, by walking it lazily.
+static Value walk(const LazyValue& value) {
+	if (value.isObject()) {
+		Value object(objectValue);
+		LazyIterator it = value.iterate();
+		while (it.next()) {
+			object[it.name()] = walk(it.value());
+		}
+		return object;
+	}
+	if (value.isArray()) {
+		Value array(arrayValue);
+		LazyIterator it = value.iterate();
+		while (it.next()) {
+			array.append(walk(it.value()));
+		}
+		return array;
+	}
+	return value.toValue();
+}
+
+static void testAgainstParse() {
+	for (size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); ++i) {
+		Value expected;
+		CHECK(parseReference(documents[i], expected));
+		LazyDocument document;
+		CHECK(document.parse(documents[i]));
+		LazyValue root = document.root();
+		CHECK(root.toValue() == expected);
+		CHECK(walk(root) == expected);
+		CHECK(root.size() == expected.size());
+		CHECK(root.type() == expected.type());
+	}
+}
+
+static void testLookups() {
+	LazyDocument document;
+	CHECK(document.parse(documents[3]));
+	LazyValue root = document.root();
+	CHECK(root["a"]["b"][ArrayIndex(0)].asBool());
+	CHECK(root["a"]["b"][ArrayIndex(2)].isNull());
+	CHECK(root["a"]["b"][ArrayIndex(3)].asString() == "x\\ny");
+	CHECK(root["a"]["b"].size() == 4);
+	CHECK(root.isMember("c"));
+	CHECK(!root.isMember("d"));
+	CHECK(root["d"].isNull());
+	CHECK(root["a"]["b"][ArrayIndex(4)].isNull());
+	CHECK(root["c"][ArrayIndex(0)].isNull());
+
+	CHECK(document.parse(documents[2]));
+	root = document.root();
+	CHECK(root[ArrayIndex(0)].type() == intValue && root[ArrayIndex(0)].asInt() == 1);
+	CHECK(root[ArrayIndex(2)].asDouble() == 3.5);
+	CHECK(root[ArrayIndex(5)].type() == uintValue);
+	CHECK(root[ArrayIndex(5)].asUInt64() == 18446744073709551615ULL);
+}
+
+/// A repeated name gives the last member, as Reader::parse() keeps it.
+static void testDuplicateNames() {
+	const char* text = "{\"a\":1,\"b\":{\"x\":1},\"a\":2,\"b\":{\"x\":3}}";
+	Value expected;
+	CHECK(parseReference(text, expected));
+	LazyDocument document;
+	CHECK(document.parse(text));
+	LazyValue root = document.root();
+	CHECK(root["a"].asInt() == expected["a"].asInt());
+	CHECK(root["a"].asInt() == 2);
+	CHECK(root["b"]["x"].asInt() == 3);
+	CHECK(root.toValue() == expected);
+	CHECK(root.size() == 4);
+}
+
+static void testErrors() {
+	LazyDocument document;
+	CHECK(!document.parse(""));
+	CHECK(!document.good());
+	CHECK(document.root().isNull());
+	CHECK(!document.parse("42"));
+	CHECK(!document.getFormattedErrorMessages().empty());
+
+	// Only what is visited is checked: malformed bytes give null cursors.
+	CHECK(document.parse("{\"a\":1,\"b\":tru}"));
+	CHECK(document.good());
+	CHECK(document.root()["b"].isNull());
+	CHECK(document.root()["a"].isNull());
+}
+
+static void testBorrowed() {
+	std::string text = "[{\"id\":7},{\"id\":8}]";
+	LazyDocument document;
+	CHECK(document.parseBorrowed(text.data(), text.length()));
+	CHECK(document.root()[1]["id"].asInt() == 8);
+}
+
+int main() {
+	testAgainstParse();
+	testLookups();
+	testDuplicateNames();
+	testErrors();
+	testBorrowed();
+	return testResult("test_lazy");
+}
@@ -0,0 +1,127 @@
+/*
+ * test_lines.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * LinesReader against Reader::parse() of each line, with one and several
+ * threads, in order and through a Consumer, failed records included.
+ */
+
+#include "test.h"
+#include <pthread.h>
+#include <map>
+
+using namespace Json;
+
+/// Collects the records of a parse, from any thread.
+class Collector: public LinesReader::Consumer {
+public:
+	Collector() {
+		pthread_mutex_init(&mutex_, NULL);
+	}
+	~Collector() {
+		pthread_mutex_destroy(&mutex_);
+	}
+	virtual void record(size_t offset, Value& value) {
+		pthread_mutex_lock(&mutex_);
+		records_[offset].swap(value);
+		pthread_mutex_unlock(&mutex_);
+	}
+
+	std::map<size_t, Value> records_;
+
+private:
+	pthread_mutex_t mutex_;
+};
+
+/// Input of many records, some of them malformed, with blank lines and
+/// CRLF line ends, and the line and offset of each record.
+static std::string buildInput(std::vector<std::string>& lines,
+		std::vector<size_t>& offsets) {
+	std::string input;
+	for (int i = 0; i < 3000; ++i) {
+		if (i % 97 == 0) {
+			input += "\n";
+		}
+		std::string line;
+		if (i % 250 == 249) {
+			line = testMalformed[1 + i % (testMalformedCount - 1)];
+		} else {
+			line = testDocuments[i % testDocumentCount];
+		}
+		// Records hold no line break: the corpus has one, at its end.
+		if (!line.empty() && line[line.size() - 1] == '\n') {
+			line.erase(line.size() - 1);
+		}
+		offsets.push_back(input.size());
+		lines.push_back(line);
+		input += line + (i % 3 == 0 ? "\r\n" : "\n");
+	}
+	return input;
+}
+
+static void testAgainstParse() {
+	std::vector<std::string> lines;
+	std::vector<size_t> offsets;
+	std::string input = buildInput(lines, offsets);
+
+	std::vector<Value> expected(lines.size());
+	size_t failed = 0;
+	for (size_t i = 0; i < lines.size(); ++i) {
+		Reader reader;
+		if (!reader.parse(lines[i], expected[i])) {
+			expected[i] = Value();
+			++failed;
+		}
+	}
+	CHECK(failed > 0);
+
+	int threadCounts[] = { 1, 2, 4, 0 };
+	for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); ++t) {
+		LinesReader reader(threadCounts[t]);
+		CHECK(reader.threads() >= 1);
+		std::vector<Value> records;
+		CHECK(!reader.parse(input, records));
+		CHECK(!reader.good());
+		CHECK(records.size() == expected.size());
+		for (size_t i = 0; i < records.size() && i < expected.size(); ++i) {
+			CHECK(records[i] == expected[i]);
+		}
+		CHECK(reader.getStructuredErrors().size() >= failed);
+
+		Collector collector;
+		CHECK(!reader.parse(input.data(), input.data() + input.size(), collector));
+		CHECK(collector.records_.size() == expected.size() - failed);
+		for (size_t i = 0; i < offsets.size(); ++i) {
+			std::map<size_t, Value>::iterator it = collector.records_.find(
+					offsets[i]);
+			if (it != collector.records_.end()) {
+				CHECK(it->second == expected[i]);
+			}
+		}
+	}
+}
+
+/// Errors are located in the whole input.
+static void testErrorLines() {
+	LinesReader reader(2);
+	std::vector<Value> records;
+	CHECK(!reader.parse(std::string("{\"a\":1}\n\n[1,\r\n[2]\r\n"), records));
+	CHECK(records.size() == 3);
+	CHECK(records[1u].isNull());
+	CHECK(records[2u][0u].asInt() == 2);
+	CHECK(reader.getFormattedErrorMessages().find("* Line 3, Column 4")
+			!= std::string::npos);
+
+	CHECK(reader.parse(std::string("[1]\n[2]"), records));
+	CHECK(reader.good());
+	CHECK(records.size() == 2);
+	CHECK(reader.parse(std::string(""), records));
+	CHECK(records.empty());
+}
+
+int main() {
+	testAgainstParse();
+	testErrorLines();
+	return testResult("test_lines");
+}
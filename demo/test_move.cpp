@@ -0,0 +1,126 @@
+/*
+ * test_move.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Moving Values: the source is left null, a subtree may be moved over the
+ * tree holding it, arrays grow by moving their elements, and append()
+ * gives back the element it added.
+ */
+
+#include "test.h"
+#include <type_traits>
+
+using namespace Json;
+
+static_assert(std::is_nothrow_move_constructible<Value>::value,
+		"std::vector must move Values when it grows");
+static_assert(std::is_nothrow_move_assignable<Value>::value,
+		"moving a Value cannot throw");
+
+static void testMoves() {
+	for (size_t i = 0; i < testDocumentCount; ++i) {
+		Value expected;
+		CHECK(parseReference(testDocuments[i], expected));
+		Value source(expected);
+
+		Value constructed(std::move(source));
+		CHECK(constructed == expected);
+		CHECK(source.isNull());
+
+		Value assigned("a string long enough to be allocated");
+		assigned = std::move(constructed);
+		CHECK(assigned == expected);
+		CHECK(constructed.isNull());
+
+		// Moved into itself, nothing changes.
+		Value& self = assigned;
+		assigned = std::move(self);
+		CHECK(assigned == expected);
+	}
+
+	Value scalars[] = { Value(), Value(-5), Value(7u), Value(2.5), Value(true),
+			Value("short"), Value("a string long enough to be allocated") };
+	for (size_t i = 0; i < sizeof(scalars) / sizeof(scalars[0]); ++i) {
+		Value copy(scalars[i]);
+		Value moved(std::move(copy));
+		CHECK(moved == scalars[i]);
+		CHECK(moved.type() == scalars[i].type());
+		CHECK(copy.isNull());
+	}
+}
+
+/// A member or element moved over the tree that holds it.
+static void testSubtrees() {
+	Value root;
+	CHECK(parseReference("{\"a\":{\"b\":[1,{\"c\":\"deep string long enough\"}]},\"d\":2}",
+			root));
+	Value expected = root["a"]["b"][1u];
+	root = std::move(root["a"]["b"][1u]);
+	CHECK(root == expected);
+
+	Value array;
+	CHECK(parseReference("[[1,2,[3]],4]", array));
+	array = std::move(array[0u][2u]);
+	CHECK(writeJson(array) == "[3]\n");
+
+	Value object(objectValue);
+	object["x"] = Value("moved string that needs the heap");
+	object["y"] = std::move(object["x"]);
+	CHECK(object["x"].isNull());
+	CHECK(object["y"].asString() == "moved string that needs the heap");
+}
+
+/// Elements keep their values as the array grows and is resized.
+static void testArrays() {
+	Value array(arrayValue);
+	for (int i = 0; i < 1000; ++i) {
+		char text[64];
+		snprintf(text, sizeof(text), "element %d with a long string", i);
+		Value element(text);
+		Value& added = array.append(std::move(element));
+		CHECK(element.isNull());
+		CHECK(&added == &array[ArrayIndex(i)]);
+		CHECK(added.asString() == text);
+	}
+	for (int i = 0; i < 1000; i += 111) {
+		char text[64];
+		snprintf(text, sizeof(text), "element %d with a long string", i);
+		CHECK(array[ArrayIndex(i)].asString() == text);
+	}
+
+	// append() returns the element, to build it in place.
+	Value& built = array.append(Value(objectValue));
+	built["k"] = 1;
+	CHECK(array[1000u]["k"].asInt() == 1);
+	Value& copied = array.append(Value(5));
+	CHECK(copied.asInt() == 5 && array.size() == 1002);
+
+	array.resize(3000);
+	CHECK(array.size() == 3000);
+	CHECK(array[999u].asString() == "element 999 with a long string");
+	CHECK(array[2999u].isNull());
+	array.resize(10);
+	CHECK(array.size() == 10);
+	CHECK(array[9u].asString() == "element 9 with a long string");
+}
+
+static void testWriter() {
+	Value expected;
+	CHECK(parseReference(testDocuments[9], expected));
+	FastWriter writer;
+	std::string first = writer.write(expected);
+	std::string second = writer.write(expected);
+	CHECK(first == second);
+	Value reread;
+	CHECK(parseReference(first, reread));
+	CHECK(reread == expected);
+}
+
+int main() {
+	testMoves();
+	testSubtrees();
+	testArrays();
+	testWriter();
+	return testResult("test_move");
+}
@@ -0,0 +1,118 @@
+/*
+ * test_number.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * parseDouble() against strtod(): hard cases of correct rounding, random
+ * doubles written back with every precision, and numbers read by Reader.
+ */
+
+#include "test.h"
+#include <cstdlib>
+#include <cstring>
+
+using namespace Json;
+
+static unsigned long long state = 42;
+
+static unsigned long long random64() {
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+static bool sameDouble(double a, double b) {
+	return memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+/// parseDouble() gives the bits strtod() gives, reading from a buffer
+/// with no NUL after the number.
+static bool matchesStrtod(const std::string& text) {
+	std::vector<char> bytes(text.begin(), text.end());
+	double value = 0;
+	if (!parseDouble(bytes.data(), bytes.data() + bytes.size(), value)) {
+		return false;
+	}
+	return sameDouble(value, strtod(text.c_str(), NULL));
+}
+
+static void testHardCases() {
+	const char* cases[] = { "0", "-0", "1", "0.1", "1e23", "8.98846567431158e307",
+			"4.9e-324", "2.4703282292062327e-324", "2.4703282292062328e-324",
+			"2.2250738585072011e-308", "2.2250738585072014e-308",
+			"1.7976931348623157e308", "1.7976931348623159e308", "1e400",
+			"-1e400", "2e-400", "9007199254740993", "9007199254740992.5",
+			"123456789012345678901234567890", "4503599627370497.5",
+			"7.2057594037927933e16", "00001.5", "1E5", "1e-5", "1e+5",
+			"1.00000000000000011102230246251565404236316680908203125",
+			"1.00000000000000011102230246251565404236316680908203124",
+			"1.00000000000000011102230246251565404236316680908203126",
+			"9007199254740993.0000000000000000000000000000001",
+			"0.000000000000000000000000000000000000000000000000000000001",
+			"1e-10000000000000", "1e10000000000000",
+			// Past the halfway point above the largest double, with more
+			// digits than the fast path settles.
+			"1.7976931348623158079372898e308",
+			"-1.7976931348623158079372898e308",
+			"1.7976931348623158079372897e308" };
+	for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+		if (!matchesStrtod(cases[i])) {
+			printf("  %s\n", cases[i]);
+			CHECK(matchesStrtod(cases[i]));
+		}
+	}
+
+	double value = 0;
+	CHECK(!parseDouble("-", strchr("-", 0), value));
+	CHECK(!parseDouble("e5", strchr("e5", 0), value));
+	// Like strtod, the longest number prefix is converted.
+	const char* prefix = "1.5e";
+	CHECK(parseDouble(prefix, prefix + 4, value) && value == 1.5);
+}
+
+static void testRandomDoubles() {
+	char text[64];
+	for (int i = 0; i < 200000; ++i) {
+		unsigned long long bits = random64();
+		double value;
+		memcpy(&value, &bits, sizeof(value));
+		if (value != value || value - value != 0) {
+			continue;
+		}
+		snprintf(text, sizeof(text), "%.*g", int(1 + i % 17), value);
+		if (!matchesStrtod(text)) {
+			printf("  %s\n", text);
+			CHECK(matchesStrtod(text));
+		}
+	}
+	for (int i = 0; i < 100000; ++i) {
+		std::string digits;
+		int count = 1 + int(random64() % 30);
+		for (int j = 0; j < count; ++j) {
+			digits += char('0' + random64() % 10);
+		}
+		snprintf(text, sizeof(text), "e%d", int(random64() % 700) - 350);
+		std::string number = digits.substr(0, 1) + "." + digits.substr(1) + text;
+		if (!matchesStrtod(number)) {
+			printf("  %s\n", number.c_str());
+			CHECK(matchesStrtod(number));
+		}
+	}
+}
+
+static void testReader() {
+	Value root;
+	CHECK(parseReference("[0.1,-2.5e-3,1e308,123456789012345678901234567890]", root));
+	CHECK(sameDouble(root[0u].asDouble(), 0.1));
+	CHECK(sameDouble(root[1u].asDouble(), -2.5e-3));
+	CHECK(sameDouble(root[2u].asDouble(), 1e308));
+	CHECK(sameDouble(root[3u].asDouble(), strtod("123456789012345678901234567890", NULL)));
+}
+
+int main() {
+	testHardCases();
+	testRandomDoubles();
+	testReader();
+	return testResult("test_number");
+}
@@ -0,0 +1,200 @@
+/*
+ * test_object.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Object members, kept in an ObjectTable: insertion order, lookups across
+ * the growth of the table, references to members staying valid and
+ * comparisons.
+ */
+
+#include "test.h"
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+
+using namespace Json;
+
+static std::string name(int i) {
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), "member%d", i);
+	return buffer;
+}
+
+/// Members keep the order they were added in; a JSON_MAP_OBJECTS build
+/// sorts them by name.
+static void testInsertionOrder() {
+	Value object(objectValue);
+	object["zebra"] = 1;
+	object["apple"] = 2;
+	object["mango"] = 3;
+	Value::Members names = object.getMemberNames();
+	CHECK(names.size() == 3);
+#ifndef JSON_MAP_OBJECTS
+	CHECK(names[0] == "zebra" && names[1] == "apple" && names[2] == "mango");
+	CHECK(writeJson(object) == "{\"zebra\":1,\"apple\":2,\"mango\":3}\n");
+#else
+	CHECK(names[0] == "apple" && names[1] == "mango" && names[2] == "zebra");
+	CHECK(writeJson(object) == "{\"apple\":2,\"mango\":3,\"zebra\":1}\n");
+#endif
+
+	object["apple"] = 4;
+	CHECK(object.getMemberNames() == names);
+	object.removeMember("zebra");
+	names = object.getMemberNames();
+	CHECK(names.size() == 2 && names[0] == "apple" && names[1] == "mango");
+
+	Value parsed;
+	CHECK(parseReference("{\"b\":1,\"a\":2,\"c\":{\"y\":1,\"x\":2}}", parsed));
+#ifndef JSON_MAP_OBJECTS
+	CHECK(writeJson(parsed) == "{\"b\":1,\"a\":2,\"c\":{\"y\":1,\"x\":2}}\n");
+#else
+	CHECK(writeJson(parsed) == "{\"a\":2,\"b\":1,\"c\":{\"x\":2,\"y\":1}}\n");
+#endif
+}
+
+/// Lookups against a std::map, on either side of the size where the
+/// table starts hashing and of each growth of its capacity.
+static void testLookups() {
+	for (int count = 0; count < 70; ++count) {
+		Value object(objectValue);
+		std::map<std::string, int> expected;
+		for (int i = 0; i < count; ++i) {
+			object[name(i)] = i;
+			expected[name(i)] = i;
+		}
+		for (int i = 0; i < count; i += 3) {
+			object.removeMember(name(i));
+			expected.erase(name(i));
+		}
+		CHECK(object.size() == expected.size());
+		for (int i = 0; i < count + 5; ++i) {
+			bool present = expected.count(name(i)) != 0;
+			CHECK(object.isMember(name(i)) == present);
+			if (present) {
+				CHECK(object[name(i)].asInt() == i);
+			}
+		}
+	}
+}
+
+/// Removing members one at a time from a large object, from the front,
+/// the back and in between, keeps the others found by name and in order.
+static void testRemovals() {
+	Value object(objectValue);
+	std::vector<std::string> order;
+	for (int i = 0; i < 2000; ++i) {
+		object[name(i)] = i;
+		order.push_back(name(i));
+	}
+	unsigned int seed = 7;
+	while (!order.empty()) {
+		seed = seed * 1103515245 + 12345;
+		size_t position = order.size() % 3 == 0 ? 0
+				: order.size() % 3 == 1 ? order.size() - 1
+				: (seed >> 8) % order.size();
+		CHECK(object.isMember(order[position]));
+		object.removeMember(order[position]);
+		CHECK(!object.isMember(order[position]));
+		order.erase(order.begin() + position);
+		if (order.size() % 97 == 0) {
+			Value::Members names(order);
+#ifdef JSON_MAP_OBJECTS
+			std::sort(names.begin(), names.end());
+#endif
+			CHECK(object.getMemberNames() == names);
+			for (size_t i = 0; i < order.size(); ++i) {
+				CHECK(object[order[i]].asInt() == atoi(order[i].c_str() + 6));
+			}
+		}
+	}
+	CHECK(object.size() == 0);
+	object["again"] = 1;
+	CHECK(object.size() == 1 && object["again"].asInt() == 1);
+}
+
+/// Adding members must not move the others, as with std::map.
+static void testMemberReferences() {
+	for (int count = 0; count < 40; ++count) {
+		Value object(objectValue);
+		for (int i = 0; i < count; ++i) {
+			object[name(i)] = i;
+		}
+		object["a"] = "a string too long to be stored inline";
+		// Adding "e" may grow the table while "a" is being read.
+		object["e"] = object["a"];
+		CHECK(object["e"] == object["a"]);
+
+		Value* member = &object["a"];
+		for (int i = 0; i < 100; ++i) {
+			object[name(1000 + i)] = i;
+		}
+		CHECK(&object["a"] == member);
+		CHECK(member->asString() == "a string too long to be stored inline");
+
+		object.removeMember(name(1000));
+		object.removeMember("e");
+		CHECK(&object["a"] == member);
+	}
+}
+
+static void testCopies() {
+	Value object(objectValue);
+	for (int i = 0; i < 20; ++i) {
+		object[name(i)] = i;
+	}
+	Value copy(object);
+	CHECK(copy == object);
+	CHECK(copy.getMemberNames() == object.getMemberNames());
+	copy[name(3)] = "changed";
+	CHECK(copy != object);
+	CHECK(object[name(3)].asInt() == 3);
+
+	Value assigned;
+	assigned = object;
+	CHECK(assigned == object);
+	CHECK(assigned.getMemberNames() == object.getMemberNames());
+}
+
+/// Equality ignores the order of the members; ordering sorts them by name.
+static void testComparisons() {
+	Value a;
+	Value b;
+	CHECK(parseReference("{\"x\":1,\"y\":{\"p\":[1,2],\"q\":null}}", a));
+	CHECK(parseReference("{\"y\":{\"q\":null,\"p\":[1,2]},\"x\":1}", b));
+	CHECK(a == b);
+	CHECK(!(a < b) && !(b < a));
+
+	b["y"]["p"][1] = 3;
+	CHECK(a != b);
+	CHECK(a < b);
+	b["y"]["p"][1] = 2;
+	b["z"] = 0;
+	CHECK(a != b);
+	CHECK(a < b);
+
+	Value c;
+	CHECK(parseReference("{\"x\":1,\"w\":{\"p\":[1,2],\"q\":null}}", c));
+	CHECK(a != c);
+	CHECK(c < a);
+
+	Value wide(objectValue);
+	Value reversed(objectValue);
+	for (int i = 0; i < 50; ++i) {
+		wide[name(i)] = i;
+		reversed[name(49 - i)] = 49 - i;
+	}
+	CHECK(wide == reversed);
+	reversed[name(7)] = 0;
+	CHECK(wide != reversed);
+}
+
+int main() {
+	testInsertionOrder();
+	testLookups();
+	testRemovals();
+	testMemberReferences();
+	testCopies();
+	testComparisons();
+	return testResult("test_object");
+}
@@ -0,0 +1,77 @@
+/*
+ * test_parallel.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Reader::parseParallel() against Reader::parse(), on arrays of many
+ * elements of every kind, on other roots, and on malformed documents.
+ */
+
+#include "test.h"
+
+using namespace Json;
+
+/// A top-level array of \c count elements taken from the corpus.
+static std::string buildArray(size_t count) {
+	std::string document = "[";
+	for (size_t i = 0; i < count; ++i) {
+		if (i != 0) {
+			document += i % 5 == 0 ? " ,\n" : ",";
+		}
+		document += testDocuments[i % testDocumentCount];
+	}
+	return document + "]";
+}
+
+static void checkSame(const std::string& document, int threads) {
+	Reader reference;
+	Value expected;
+	bool ok = reference.parse(document, expected);
+
+	Reader reader;
+	Value root;
+	CHECK(reader.parseParallel(document.data(),
+			document.data() + document.size(), root, threads) == ok);
+	CHECK(reader.getFormattedErrorMessages()
+			== reference.getFormattedErrorMessages());
+	if (ok) {
+		CHECK(root == expected);
+	}
+}
+
+static void testAgainstParse() {
+	size_t counts[] = { 0, 1, 2, 3, 7, 100, 5000 };
+	int threads[] = { 1, 2, 3, 8, 0 };
+	for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+		std::string document = buildArray(counts[c]);
+		for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); ++t) {
+			checkSame(document, threads[t]);
+		}
+	}
+	// Roots that are not arrays are read serially.
+	for (size_t i = 0; i < testDocumentCount; ++i) {
+		checkSame(testDocuments[i], 4);
+	}
+}
+
+/// Failures anywhere in the array give the errors of the serial parse.
+static void testErrors() {
+	std::string document = buildArray(3000);
+	size_t positions[] = { 1, document.size() / 3, document.size() / 2,
+			document.size() - 2 };
+	for (size_t p = 0; p < sizeof(positions) / sizeof(positions[0]); ++p) {
+		std::string broken = document;
+		broken.insert(positions[p], "}");
+		checkSame(broken, 4);
+	}
+	checkSame(document.substr(0, document.size() - 1), 4);
+	for (size_t i = 0; i < testMalformedCount; ++i) {
+		checkSame(testMalformed[i], 4);
+	}
+}
+
+int main() {
+	testAgainstParse();
+	testErrors();
+	return testResult("test_parallel");
+}
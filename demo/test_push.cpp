@@ -0,0 +1,168 @@
+/*
+ * test_push.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * PushReader against Reader::parse(): documents fed in two chunks split at
+ * every byte, one byte at a time and in random chunks, errors included.
+ */
+
+#include "test.h"
+#include <cstdlib>
+
+using namespace Json;
+
+/// Feed \c text to a new PushReader, cut at the offsets in \c cuts.
+static bool pushParse(const std::string& text, const std::vector<size_t>& cuts,
+		Value& root, std::string& errors) {
+	PushReader reader(root);
+	size_t start = 0;
+	for (size_t i = 0; i <= cuts.size(); ++i) {
+		size_t end = i < cuts.size() ? cuts[i] : text.size();
+		// Each chunk is a copy of its own, so reading past it shows.
+		std::vector<char> chunk(text.begin() + start, text.begin() + end);
+		reader.feed(chunk.data(), chunk.size());
+		start = end;
+	}
+	bool ok = reader.finish();
+	errors = reader.getFormattedErrorMessages();
+	return ok;
+}
+
+static void checkSplits(const std::string& text) {
+	Reader reference;
+	Value expected;
+	bool expectedOk = reference.parse(text, expected);
+	std::string expectedErrors = reference.getFormattedErrorMessages();
+
+	std::vector<std::vector<size_t> > splits;
+	for (size_t cut = 0; cut <= text.size(); ++cut) {
+		splits.push_back(std::vector<size_t>(1, cut));
+	}
+	std::vector<size_t> bytes;
+	for (size_t cut = 1; cut < text.size(); ++cut) {
+		bytes.push_back(cut);
+	}
+	splits.push_back(bytes);
+	for (int round = 0; round < 20; ++round) {
+		std::vector<size_t> cuts;
+		for (size_t cut = rand() % 7; cut < text.size(); cut += 1 + rand() % 9) {
+			cuts.push_back(cut);
+		}
+		splits.push_back(cuts);
+	}
+
+	for (size_t i = 0; i < splits.size(); ++i) {
+		Value root;
+		std::string errors;
+		bool ok = pushParse(text, splits[i], root, errors);
+		CHECK(ok == expectedOk);
+		if (ok) {
+			CHECK(root == expected);
+		} else {
+			CHECK(errors == expectedErrors);
+		}
+	}
+}
+
+static void testAgainstParse() {
+	for (size_t i = 0; i < testDocumentCount; ++i) {
+		checkSplits(testDocuments[i]);
+	}
+	for (size_t i = 0; i < testMalformedCount; ++i) {
+		checkSplits(testMalformed[i]);
+	}
+	// Tokens cut short by the end of the input.
+	checkSplits("[12345");
+	checkSplits("[\"abc\\u00");
+	checkSplits("{\"a\":nul");
+	checkSplits("[1.5e+");
+	// Roots that are not containers, with errors of their own.
+	checkSplits(":{");
+	checkSplits(" : }");
+	checkSplits("\"\\u07f\":1");
+	checkSplits("\"a\\x\"");
+	checkSplits("-e5,");
+	checkSplits("\"fine\"");
+	checkSplits("]");
+}
+
+static void testEvents() {
+	Value fromEvents;
+	ValueBuilder builder(fromEvents);
+	PushReader reader(builder);
+	CHECK(reader.feed("{\"a\":[1,2"));
+	CHECK(!reader.done());
+	CHECK(reader.feed(std::string("],\"b\":\"x\"}")));
+	CHECK(reader.done());
+	CHECK(reader.finish());
+	CHECK(writeJson(fromEvents) == "{\"a\":[1,2],\"b\":\"x\"}\n");
+}
+
+static void testReset() {
+	Value root;
+	PushReader reader(root);
+	CHECK(!reader.feed("[1,}"));
+	CHECK(!reader.good());
+	CHECK(!reader.feed("]"));
+
+	reader.reset();
+	CHECK(reader.good());
+	CHECK(reader.feed("[3,4]"));
+	CHECK(reader.finish());
+	CHECK(root.size() == 2 && root[1u].asInt() == 4);
+}
+
+/// Arrays and objects alternately, \c depth containers deep.
+static std::string nested(size_t depth) {
+	std::string open;
+	std::string close;
+	for (size_t i = 0; i < depth; ++i) {
+		open += i % 2 == 0 ? "[" : "{\"k\":";
+		close += i % 2 == 0 ? "]" : "}";
+	}
+	return open + "1" + std::string(close.rbegin(), close.rend());
+}
+
+/// The nesting limit of Reader, with its error.
+static void testStackLimit() {
+	Value root;
+	PushReader reader(root);
+	CHECK(reader.stackLimit() == 1000);
+	CHECK(reader.feed(nested(1000)));
+	CHECK(reader.finish());
+
+	unsigned int limits[] = { 1, 2, 7, 1000 };
+	for (size_t l = 0; l < sizeof(limits) / sizeof(limits[0]); ++l) {
+		std::string deeper = nested(limits[l] + 1);
+		Reader reference;
+		reference.setStackLimit(limits[l]);
+		Value expected;
+		CHECK(!reference.parse(deeper, expected));
+
+		reader.reset();
+		reader.setStackLimit(limits[l]);
+		CHECK(!reader.feed(deeper));
+		CHECK(!reader.finish());
+		CHECK(reader.getFormattedErrorMessages()
+				== reference.getFormattedErrorMessages());
+	}
+
+	// A million brackets fail at the limit, well before the tree is too
+	// deep to destroy.
+	reader.reset();
+	reader.setStackLimit(1000);
+	CHECK(!reader.feed(std::string(1000000, '[')));
+	CHECK(!reader.feed(std::string(1000000, ']')));
+	CHECK(!reader.finish());
+	CHECK(reader.getFormattedErrorMessages().find(
+			"Exceeded the nesting limit of the reader.") != std::string::npos);
+}
+
+int main() {
+	testAgainstParse();
+	testEvents();
+	testReset();
+	testStackLimit();
+	return testResult("test_push");
+}
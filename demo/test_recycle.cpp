@@ -0,0 +1,101 @@
+/*
+ * test_recycle.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Reading documents one after the other into the same Value, with and
+ * without Reader::setRecycling(), against a fresh Reader::parse() of each.
+ */
+
+#include "test.h"
+#include <algorithm>
+
+using namespace Json;
+
+/// Documents of changing shapes: members added, dropped, reordered and
+/// repeated, values changing type, strings growing and shrinking.
+static const char* const sequence[] = {
+	"{\"a\":1,\"b\":\"a string long enough for the heap\",\"c\":[1,2,3],\"d\":{\"x\":1}}",
+	"{\"a\":2,\"b\":\"short\",\"c\":[4],\"d\":{\"x\":2,\"y\":3}}",
+	"{\"d\":{\"y\":4},\"c\":[],\"b\":\"another string long enough for the heap\",\"a\":3}",
+	"{\"a\":[1],\"b\":{\"c\":1},\"c\":\"s\",\"d\":null}",
+	"{\"a\":1,\"a\":2,\"b\":1,\"a\":3}",
+	"{\"k1\":1,\"k2\":2,\"k3\":3,\"k4\":4,\"k5\":5,\"k6\":6,\"k7\":7,\"k8\":8,\"k9\":9,\"k10\":10}",
+	"{\"k10\":1,\"k9\":2,\"k1\":3}",
+	"{\"k1\":1,\"k2\":2,\"k3\":3,\"k4\":4,\"k5\":5,\"k6\":6,\"k7\":7,\"k8\":8,\"k9\":9,\"k10\":10,\"k11\":11,\"k12\":12}",
+	"[1,2,3]",
+	"[[1,2],[3]]",
+	"[[1],[2,3,4],{\"a\":1}]",
+	"{}",
+	"[]",
+	"{\"a\":{\"b\":{\"c\":{\"d\":[1,{\"e\":\"f\"}]}}}}",
+	"{\"a\":{\"b\":{\"c\":{\"d\":[2]}}}}",
+};
+
+static const size_t sequenceCount = sizeof(sequence) / sizeof(sequence[0]);
+
+static void checkSequence(const std::vector<std::string>& documents,
+		bool recycling) {
+	Reader reader;
+	reader.setRecycling(recycling);
+	Value root;
+	for (size_t i = 0; i < documents.size(); ++i) {
+		Reader reference;
+		Value expected;
+		bool ok = reference.parse(documents[i], expected);
+		CHECK(reader.parse(documents[i], root) == ok);
+		if (ok) {
+			CHECK(root == expected);
+			// Members are in the order of the new document.
+			CHECK(writeJson(root) == writeJson(expected));
+		} else {
+			CHECK(reader.getFormattedErrorMessages()
+					== reference.getFormattedErrorMessages());
+		}
+	}
+}
+
+static void testAgainstParse() {
+	std::vector<std::string> documents(sequence, sequence + sequenceCount);
+	documents.insert(documents.end(), testDocuments,
+			testDocuments + testDocumentCount);
+	for (int round = 0; round < 2; ++round) {
+		checkSequence(documents, true);
+		checkSequence(documents, false);
+		// Backwards, every change of shape is undone.
+		std::reverse(documents.begin(), documents.end());
+	}
+
+	// A failed parse in between leaves a tree the next one recycles.
+	std::vector<std::string> interleaved;
+	for (size_t i = 0; i < sequenceCount; ++i) {
+		interleaved.push_back(sequence[i]);
+		interleaved.push_back(testMalformed[i % testMalformedCount]);
+		std::string cut = sequence[i];
+		interleaved.push_back(cut.substr(0, cut.size() / 2));
+	}
+	checkSequence(interleaved, true);
+}
+
+/// Each document of the same shape as the previous one.
+static void testSameShape() {
+	Reader reader;
+	reader.setRecycling(true);
+	Value root;
+	for (int i = 0; i < 1000; ++i) {
+		char document[256];
+		snprintf(document, sizeof(document),
+				"{\"id\":%d,\"name\":\"name number %d of the records\",\"tags\":[%d,%d],\"ok\":%s}",
+				i, i, i, i * 2, i % 2 ? "true" : "false");
+		Value expected;
+		CHECK(parseReference(document, expected));
+		CHECK(reader.parse(document, root));
+		CHECK(root == expected);
+	}
+}
+
+int main() {
+	testAgainstParse();
+	testSameShape();
+	return testResult("test_recycle");
+}
@@ -0,0 +1,155 @@
+/*
+ * test_scan.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * scanNumber() and skipNumber() against a plain reading of the token:
+ * where it ends, its integer value across the eight digit steps and the 64
+ * bit limit, and numbers in skipped values, which are only delimited.
+ */
+
+#include "test.h"
+#include <cstdlib>
+#include <cerrno>
+
+using namespace Json;
+
+static bool isDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+/// End of <tt>-?digits[.digits][(e|E)[+-]digits]</tt>, any part empty.
+static size_t tokenEnd(const std::string& text) {
+	size_t i = 0;
+	if (i < text.size() && text[i] == '-') {
+		++i;
+	}
+	while (i < text.size() && isDigit(text[i])) {
+		++i;
+	}
+	if (i < text.size() && text[i] == '.') {
+		++i;
+		while (i < text.size() && isDigit(text[i])) {
+			++i;
+		}
+	}
+	if (i < text.size() && (text[i] == 'e' || text[i] == 'E')) {
+		++i;
+		if (i < text.size() && (text[i] == '+' || text[i] == '-')) {
+			++i;
+		}
+		while (i < text.size() && isDigit(text[i])) {
+			++i;
+		}
+	}
+	return i;
+}
+
+/// Both functions, on a copy with nothing readable past its end.
+static void checkToken(const std::string& text) {
+	std::vector<char> bytes(text.begin(), text.end());
+	const char* begin = bytes.data();
+	const char* end = begin + bytes.size();
+	NumberParts number;
+	const char* scanned = scanNumber(begin, end, number);
+	CHECK(size_t(scanned - begin) == tokenEnd(text));
+	CHECK(skipNumber(begin, end) == scanned);
+}
+
+static void testTokenEnds() {
+	const char alphabet[] = "0123456789-+.eE x";
+	for (int round = 0; round < 100000; ++round) {
+		std::string text;
+		size_t length = rand() % 30;
+		for (size_t i = 0; i < length; ++i) {
+			text += alphabet[rand() % (sizeof(alphabet) - 1)];
+		}
+		checkToken(text);
+	}
+	// Long runs of digits, so every eight digit step and its remainder is
+	// taken.
+	for (size_t digits = 0; digits < 40; ++digits) {
+		std::string run(digits, '7');
+		checkToken(run);
+		checkToken("-" + run + ",");
+		checkToken("1." + run + "e-" + run + "]");
+	}
+}
+
+/// Integral tokens hold their exact value when it fits in 64 bits.
+static void checkInteger(const std::string& text) {
+	NumberParts number;
+	scanNumber(text.data(), text.data() + text.size(), number);
+	errno = 0;
+	const char* digits = text.c_str() + (text[0] == '-' ? 1 : 0);
+	unsigned long long expected = strtoull(digits, NULL, 10);
+	bool fits = errno != ERANGE;
+	CHECK(number.integral_ == fits);
+	CHECK(number.negative_ == (text[0] == '-'));
+	if (fits) {
+		CHECK(number.integer_ == expected);
+	}
+
+	// Reader keeps integers as integers as long as they fit.
+	Reader reader;
+	Value root;
+	CHECK(reader.parse("[" + text + "]", root));
+	const Value& value = root[0u];
+	double nearest = strtod(text.c_str(), NULL);
+	if (text[0] == '-' && fits && expected <= 9223372036854775808ULL) {
+		CHECK(value.isIntegral());
+		CHECK(value.asLargestInt() == Value::LargestInt(-expected));
+	} else if (text[0] != '-' && fits) {
+		CHECK(value.isIntegral());
+		CHECK(value.asLargestUInt() == expected);
+	} else {
+		CHECK(value.isDouble());
+		CHECK(value.asDouble() == nearest);
+	}
+}
+
+static void testIntegers() {
+	std::string digits = "1234567890123456789012345";
+	for (size_t length = 1; length <= digits.size(); ++length) {
+		checkInteger(digits.substr(0, length));
+		checkInteger("-" + digits.substr(0, length));
+	}
+	const char* const limits[] = { "0", "-0", "4294967295", "4294967296",
+			"9223372036854775807", "9223372036854775808", "9223372036854775809",
+			"18446744073709551615", "18446744073709551616",
+			"99999999999999999999", "100000000000000000000",
+			"00000000000000000000000000001", "-9223372036854775808",
+			"-9223372036854775809", "-18446744073709551615" };
+	for (size_t i = 0; i < sizeof(limits) / sizeof(limits[0]); ++i) {
+		checkInteger(limits[i]);
+	}
+}
+
+/// Numbers only converted when a value is built: a skipped number that
+/// does not convert is not an error, a built one is.
+static void testSkipped() {
+	std::string document = "{\"keep\":[1,2.5,-3],\"skip\":[-,1e,-.e+,99999999999999999999999,1.5]}";
+	Reader reader;
+	Value root;
+	CHECK(!reader.parse(document, root));
+
+	std::vector<std::string> paths(1, "/keep");
+	Selection selection(paths);
+	CHECK(reader.parse(document, selection, root));
+	CHECK(root["keep"].size() == 3 && root["keep"][1u].asDouble() == 2.5);
+	CHECK(!root.isMember("skip"));
+
+	KeyFilter filter;
+	filter.deny("skip");
+	reader.setKeyFilter(&filter);
+	CHECK(reader.parse(document, root));
+	CHECK(root["keep"][2u].asInt() == -3);
+	CHECK(!root.isMember("skip"));
+}
+
+int main() {
+	testTokenEnds();
+	testIntegers();
+	testSkipped();
+	return testResult("test_scan");
+}
@@ -0,0 +1,179 @@
+/*
+ * test_selection.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Reader::parse() with a Selection against the same projection done on the
+ * whole tree, and the paths Selection accepts.
+ */
+
+#include "test.h"
+
+using namespace Json;
+
+typedef std::vector<std::string> Segments;
+
+/// Split a JSON Pointer, assumed valid, into its decoded segments.
+static Segments split(const std::string& path) {
+	Segments segments;
+	for (size_t i = 0; i < path.size(); ++i) {
+		if (path[i] == '/') {
+			segments.push_back("");
+		} else if (path[i] == '~') {
+			segments.back() += path[++i] == '1' ? '/' : '~';
+		} else {
+			segments.back() += path[i];
+		}
+	}
+	return segments;
+}
+
+/// The paths of \c paths that continue through \c name, without it.
+static std::vector<Segments> follow(const std::vector<Segments>& paths,
+		const std::string& name) {
+	std::vector<Segments> next;
+	for (size_t i = 0; i < paths.size(); ++i) {
+		if (paths[i][0] == name || paths[i][0] == "*") {
+			next.push_back(Segments(paths[i].begin() + 1, paths[i].end()));
+		}
+	}
+	return next;
+}
+
+/// What a selective parse of \c paths should build from \c value.
+static Value project(const Value& value, const std::vector<Segments>& paths) {
+	for (size_t i = 0; i < paths.size(); ++i) {
+		if (paths[i].empty()) {
+			return value;
+		}
+	}
+	if (value.isObject()) {
+		Value result(objectValue);
+		Value::Members names = value.getMemberNames();
+		for (size_t i = 0; i < names.size(); ++i) {
+			std::vector<Segments> next = follow(paths, names[i]);
+			if (!next.empty()) {
+				result[names[i]] = project(value[names[i]], next);
+			}
+		}
+		return result;
+	}
+	if (value.isArray()) {
+		Value result(arrayValue);
+		for (ArrayIndex i = 0; i < value.size(); ++i) {
+			char index[16];
+			snprintf(index, sizeof(index), "%u", i);
+			std::vector<Segments> next = follow(paths, index);
+			if (!next.empty()) {
+				result[i] = project(value[i], next);
+			}
+		}
+		return result;
+	}
+	return value;
+}
+
+static void checkSelection(const std::string& document,
+		const std::vector<std::string>& paths) {
+	Value whole;
+	CHECK(parseReference(document, whole));
+	std::vector<Segments> splitPaths;
+	for (size_t i = 0; i < paths.size(); ++i) {
+		splitPaths.push_back(split(paths[i]));
+	}
+	Value expected = whole.isObject() || whole.isArray() ?
+			project(whole, splitPaths) : whole;
+
+	Selection selection(paths);
+	Reader reader;
+	Value root;
+	CHECK(reader.parse(document, selection, root));
+	CHECK(root == expected);
+	if (!(root == expected)) {
+		printf("  %s\n  got %s  expected %s", document.c_str(),
+				writeJson(root).c_str(), writeJson(expected).c_str());
+	}
+}
+
+static void testAgainstProjection() {
+	const char* const pathSets[][3] = {
+		{ "/nested/k3", "/tags/1", NULL },
+		{ "/*/id", "/1/v", NULL },
+		{ "/*", NULL, NULL },
+		{ "/0/a/1/b/1", "/1", NULL },
+		{ "/escapes", "/utf8", "/dup" },
+		{ "/nested", "/nested/k1", NULL },
+		{ "/4/id", "/missing", NULL },
+		{ "/*/*", NULL, NULL },
+		{ "/0/0/0/0/0", NULL, NULL },
+		{ "", NULL, NULL },
+	};
+	for (size_t s = 0; s < sizeof(pathSets) / sizeof(pathSets[0]); ++s) {
+		std::vector<std::string> paths;
+		for (size_t p = 0; p < 3 && pathSets[s][p] != NULL; ++p) {
+			paths.push_back(pathSets[s][p]);
+		}
+		for (size_t i = 0; i < testDocumentCount; ++i) {
+			checkSelection(testDocuments[i], paths);
+		}
+	}
+
+	std::string events = "{\"events\":[";
+	for (int i = 0; i < 200; ++i) {
+		char event[128];
+		snprintf(event, sizeof(event),
+				"%s{\"ts\":%d,\"kind\":\"k%d\",\"data\":{\"x\":[%d,\"s\"]}}",
+				i == 0 ? "" : ",", i, i % 3, i);
+		events += event;
+	}
+	events += "],\"a/b\":1,\"m~n\":[2],\"\":3}";
+	const char* const eventPaths[][2] = {
+		{ "/events/*/ts", "/events/7" },
+		{ "/events/*/data/x/0", "/" },
+		{ "/a~1b", "/m~0n/0" },
+		{ "/events/150/kind", "/events/3/data" },
+	};
+	for (size_t s = 0; s < sizeof(eventPaths) / sizeof(eventPaths[0]); ++s) {
+		checkSelection(events, std::vector<std::string>(eventPaths[s],
+				eventPaths[s] + 2));
+	}
+}
+
+/// Errors outside the skipped values are still reported.
+static void testErrors() {
+	std::vector<std::string> paths(1, "/a");
+	Selection selection(paths);
+	for (size_t i = 0; i < testMalformedCount; ++i) {
+		if (std::string(testMalformed[i]).find("\"a\"") != std::string::npos) {
+			continue;
+		}
+		Reader reader;
+		Value root;
+		CHECK(!reader.parse(testMalformed[i], selection, root));
+	}
+	Reader reader;
+	Value root;
+	CHECK(!reader.parse("{\"a\":[1,}", selection, root));
+	// Inside a skipped value, the error goes unnoticed.
+	CHECK(reader.parse("{\"b\":[1 2],\"a\":3}", selection, root));
+	CHECK(root["a"].asInt() == 3 && !root.isMember("b"));
+}
+
+static void testPaths() {
+	Selection selection;
+	CHECK(selection.empty());
+	CHECK(!selection.add("a"));
+	CHECK(!selection.add("/a~2"));
+	CHECK(selection.add("/a/~0~1"));
+	CHECK(selection.add("/"));
+	CHECK(!selection.empty());
+	selection.clear();
+	CHECK(selection.empty());
+}
+
+int main() {
+	testAgainstProjection();
+	testErrors();
+	testPaths();
+	return testResult("test_selection");
+}
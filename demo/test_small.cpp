@@ -0,0 +1,117 @@
+/*
+ * test_small.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Objects on either side of the size where members get hashed: names
+ * differing in a single byte, random insertions and removals crossing the
+ * size both ways, and recycled parses growing and shrinking objects.
+ */
+
+#include "test.h"
+#include <cstdlib>
+#include <map>
+
+using namespace Json;
+
+/// Names of the same length, differing in the byte at \c position only.
+static void testSimilarNames() {
+	for (size_t length = 1; length <= 24; ++length) {
+		for (size_t position = 0; position < length; ++position) {
+			Value object(objectValue);
+			std::string base(length, 'n');
+			for (int c = 0; c < 12; ++c) {
+				std::string name = base;
+				name[position] = char('a' + c);
+				object[name] = c;
+			}
+			object[base] = -1;
+			object[base.substr(1)] = -2;
+			CHECK(object.size() == 14);
+			for (int c = 0; c < 12; ++c) {
+				std::string name = base;
+				name[position] = char('a' + c);
+				CHECK(object.isMember(name) && object[name].asInt() == c);
+				name[position] = char('A' + c);
+				CHECK(!object.isMember(name));
+			}
+			CHECK(object[base].asInt() == -1);
+			CHECK(object[base.substr(1)].asInt() == -2);
+			CHECK(object.size() == 14);
+		}
+	}
+}
+
+/// Random changes keeping the object between 0 and 20 members.
+static void testChurn() {
+	Value object(objectValue);
+	std::map<std::string, int> expected;
+	for (int step = 0; step < 20000; ++step) {
+		char name[8];
+		snprintf(name, sizeof(name), "m%d", rand() % 20);
+		switch (rand() % 3) {
+		case 0:
+			object[name] = step;
+			expected[name] = step;
+			break;
+		case 1:
+			object.removeMember(name);
+			expected.erase(name);
+			break;
+		default:
+			CHECK(object.isMember(name) == (expected.count(name) != 0));
+			break;
+		}
+		if (step % 97 == 0) {
+			CHECK(object.size() == expected.size());
+			for (std::map<std::string, int>::iterator it = expected.begin();
+					it != expected.end(); ++it) {
+				CHECK(object[it->first].asInt() == it->second);
+			}
+			Value copy(object);
+			CHECK(copy == object);
+		}
+	}
+}
+
+/// An object of \c count members, in an order given by \c shift.
+static std::string document(int count, int shift) {
+	std::string text = "{";
+	for (int i = 0; i < count; ++i) {
+		char member[32];
+		snprintf(member, sizeof(member), "%s\"k%d\":%d", i == 0 ? "" : ",",
+				(i + shift) % count, i);
+		text += member;
+	}
+	return text + "}";
+}
+
+/// Recycling claims members of the previous object, hashed or not.
+static void testRecycled() {
+	Reader reader;
+	reader.setRecycling(true);
+	Value root;
+	int counts[] = { 7, 8, 9, 10, 8, 3, 12, 9, 1, 9, 8, 0, 16 };
+	for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+		for (int shift = 0; shift < 3; ++shift) {
+			std::string text = document(counts[c], shift);
+			Value expected;
+			CHECK(parseReference(text, expected));
+			CHECK(reader.parse(text, root));
+			CHECK(root == expected);
+			CHECK(writeJson(root) == writeJson(expected));
+			for (int i = 0; i < counts[c] + 2; ++i) {
+				char name[16];
+				snprintf(name, sizeof(name), "k%d", i);
+				CHECK(root.isMember(name) == (i < counts[c]));
+			}
+		}
+	}
+}
+
+int main() {
+	testSimilarNames();
+	testChurn();
+	testRecycled();
+	return testResult("test_small");
+}
@@ -0,0 +1,85 @@
+/*
+ * test_stats.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * ReaderStats: counts of a known document in builds with JSON_READER_STATS,
+ * zero without it, and add() and clear() either way. Build the test with
+ * the flags of the library.
+ */
+
+#include "test.h"
+
+using namespace Json;
+
+static void testCounts() {
+	const std::string document =
+			"{\"a\" : [1, 2.5, \"s\\n\", true, false, null], \"b\":{}}";
+	Reader reader;
+	Value root;
+	CHECK(reader.parse(document, root));
+	const ReaderStats& stats = reader.stats();
+#ifdef JSON_READER_STATS
+	CHECK(stats.objectBegins_ == 2 && stats.objectEnds_ == 2);
+	CHECK(stats.arrayBegins_ == 1 && stats.arrayEnds_ == 1);
+	CHECK(stats.strings_ == 3);
+	CHECK(stats.numbers_ == 2);
+	CHECK(stats.trues_ == 1 && stats.falses_ == 1 && stats.nulls_ == 1);
+	CHECK(stats.commas_ == 6 && stats.colons_ == 2);
+	CHECK(stats.errors_ == 0);
+	CHECK(stats.escapedStrings_ == 1);
+	CHECK(stats.integers_ == 1 && stats.doubles_ == 1);
+	CHECK(stats.containers_ == 3);
+	CHECK(stats.maxDepth_ == 2);
+	CHECK(stats.numberBytes_ == 4);
+	CHECK(stats.literalBytes_ == 13);
+	CHECK(stats.whitespaceBytes_ == 8);
+	// Every byte is in a token or between two, the 14 structural ones
+	// included.
+	CHECK(stats.stringBytes_ + stats.numberBytes_ + stats.literalBytes_
+			+ stats.whitespaceBytes_ + 14 == document.size());
+
+	// Each parse counts afresh; bad tokens are counted.
+	CHECK(!reader.parse("[1,@]", root));
+	CHECK(reader.stats().numbers_ == 1);
+	CHECK(reader.stats().errors_ == 1);
+
+	// Skipped values are not tokenized.
+	std::vector<std::string> paths(1, "/b");
+	Selection selection(paths);
+	CHECK(reader.parse(document, selection, root));
+	CHECK(reader.stats().numbers_ == 0);
+	CHECK(reader.stats().arrayBegins_ == 0);
+#else
+	CHECK(stats.objectBegins_ == 0 && stats.strings_ == 0);
+	CHECK(stats.numbers_ == 0 && stats.containers_ == 0);
+	CHECK(stats.maxDepth_ == 0 && stats.whitespaceBytes_ == 0);
+#endif
+}
+
+static void testAdd() {
+	ReaderStats total;
+	CHECK(total.numbers_ == 0 && total.maxDepth_ == 0);
+	ReaderStats one;
+	one.numbers_ = 3;
+	one.maxDepth_ = 5;
+	one.stringBytes_ = 10;
+	ReaderStats two;
+	two.numbers_ = 4;
+	two.maxDepth_ = 2;
+	two.slowDoubles_ = 1;
+	total.add(one);
+	total.add(two);
+	CHECK(total.numbers_ == 7);
+	CHECK(total.maxDepth_ == 5);
+	CHECK(total.stringBytes_ == 10 && total.slowDoubles_ == 1);
+	total.clear();
+	CHECK(total.numbers_ == 0 && total.maxDepth_ == 0
+			&& total.stringBytes_ == 0);
+}
+
+int main() {
+	testCounts();
+	testAdd();
+	return testResult("test_stats");
+}
@@ -0,0 +1,111 @@
+/*
+ * test_string.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * String Values on both sides of the inline limit: every length from empty
+ * to well past it, embedded NULs, copies, assignments between short and
+ * long strings, and strings read by Reader.
+ */
+
+#include "test.h"
+
+using namespace Json;
+
+/// \c length bytes, NULs and high bytes included.
+static std::string bytes(size_t length) {
+	std::string text;
+	for (size_t i = 0; i < length; ++i) {
+		text += i % 7 == 3 ? '\0' : char('a' + i % 26);
+	}
+	if (length > 5) {
+		text[5] = '\xe9';
+	}
+	return text;
+}
+
+static void testLengths() {
+	CHECK(sizeof(Value) == 16);
+	for (size_t length = 0; length <= 40; ++length) {
+		std::string text = bytes(length);
+		Value value(text.data(), text.data() + text.size(), NULL);
+		CHECK(value.isString());
+		CHECK(value.asString() == text);
+		CHECK(value.size() == length);
+
+		Value copy(value);
+		CHECK(copy.asString() == text);
+		CHECK(copy == value);
+
+		// Every other length assigned over it, and back.
+		for (size_t other = 0; other <= 40; other += 3) {
+			std::string otherText = bytes(other);
+			Value target(otherText.data(), otherText.data() + otherText.size(),
+					NULL);
+			target = value;
+			CHECK(target.asString() == text);
+			target = Value(otherText.data(), otherText.data() + otherText.size(),
+					NULL);
+			CHECK(target.asString() == otherText);
+			CHECK((target == value) == (other == length));
+			CHECK((target < value) == (otherText < text));
+
+			target.swap(copy);
+			CHECK(target.asString() == text && copy.asString() == otherText);
+			target.swap(copy);
+		}
+
+		Value moved(std::move(copy));
+		CHECK(moved.asString() == text);
+		CHECK(copy.isNull());
+	}
+}
+
+static void testTerminated() {
+	// c_str() constructors stop at the first NUL.
+	for (size_t length = 0; length <= 20; ++length) {
+		std::string text(length, 'x');
+		Value value(text.c_str());
+		CHECK(value.asString() == text);
+		CHECK(Value(text).asString() == text);
+		CHECK(Value(text) == value);
+	}
+	Value value("");
+	CHECK(value.isString() && value.asString().empty());
+	CHECK(!(value == Value()));
+	// size() is the length of a string, 0 for other scalars.
+	CHECK(Value().size() == 0 && Value(5).size() == 0 && Value(true).size() == 0);
+}
+
+/// Strings read and written back, from empty to past the limit, with
+/// escapes expanding or shrinking them around it.
+static void testRead() {
+	Reader reader;
+	for (size_t length = 0; length <= 20; ++length) {
+		std::string text(length, 'q');
+		std::string escaped = text;
+		if (length > 0) {
+			escaped.replace(0, 1, "\\u0071");
+		}
+		Value root;
+		CHECK(reader.parse("[\"" + text + "\",\"" + escaped + "\"]", root));
+		CHECK(root[0u].asString() == text);
+		CHECK(root[1u].asString() == text);
+		CHECK(root[0u] == root[1u]);
+		CHECK(writeJson(root) == "[\"" + text + "\",\"" + text + "\"]\n");
+
+		Document document;
+		CHECK(reader.parse("{\"s\":\"" + escaped + "\"}", document));
+		CHECK(document.root()["s"].asString() == text);
+		Value copy(document.root()["s"]);
+		document.clear();
+		CHECK(copy.asString() == text);
+	}
+}
+
+int main() {
+	testLengths();
+	testTerminated();
+	testRead();
+	return testResult("test_string");
+}
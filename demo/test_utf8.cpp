@@ -0,0 +1,136 @@
+/*
+ * test_utf8.cpp
+ *
+ *  Created on: 2026-10-17
+ *
+ * Reader::setStrictUtf8() against a byte by byte UTF-8 validator, on
+ * sequences at every offset of the blocks the index reads, and on random
+ * bytes.
+ */
+
+#include "test.h"
+#include <cstdlib>
+
+using namespace Json;
+
+/// Whether \c text is well-formed UTF-8, as RFC 3629 defines it.
+static bool validUtf8(const std::string& text) {
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(text.data());
+	const unsigned char* end = p + text.size();
+	while (p < end) {
+		unsigned int c = *p++;
+		if (c < 0x80) {
+			continue;
+		}
+		size_t count;
+		unsigned int min;
+		if (c >= 0xC2 && c <= 0xDF) {
+			count = 1;
+			min = 0x80;
+			c &= 0x1F;
+		} else if (c >= 0xE0 && c <= 0xEF) {
+			count = 2;
+			min = 0x800;
+			c &= 0x0F;
+		} else if (c >= 0xF0 && c <= 0xF4) {
+			count = 3;
+			min = 0x10000;
+			c &= 0x07;
+		} else {
+			return false;
+		}
+		for (size_t i = 0; i < count; ++i) {
+			if (p == end || (*p & 0xC0) != 0x80) {
+				return false;
+			}
+			c = (c << 6) | (*p++ & 0x3F);
+		}
+		if (c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/// \c bytes in a string of an array, \c offset bytes into the document.
+static void checkString(const std::string& bytes, size_t offset) {
+	std::string document = std::string(offset, ' ') + "[\"" + bytes + "\"]";
+	Reader lenient;
+	Value expected;
+	CHECK(lenient.parse(document, expected));
+
+	Reader reader;
+	reader.setStrictUtf8(true);
+	Value root;
+	bool valid = validUtf8(bytes);
+	CHECK(reader.parse(document, root) == valid);
+	if (valid) {
+		CHECK(root == expected);
+	} else {
+		CHECK(reader.getFormattedErrorMessages().find("Invalid UTF-8")
+				!= std::string::npos);
+	}
+}
+
+static void testSequences() {
+	const char* const sequences[] = {
+		"", "plain ascii",
+		"\xc3\xa9", "\xe4\xb8\xad", "\xf0\x9f\x98\x80", "\xf4\x8f\xbf\xbf",
+		"\xef\xbf\xbf", "\xed\x9f\xbf", "\xee\x80\x80", "\xc2\x80", "\xdf\xbf",
+		// Overlong forms.
+		"\xc0\x80", "\xc1\xbf", "\xe0\x80\x80", "\xe0\x9f\xbf", "\xf0\x80\x80\x80",
+		"\xf0\x8f\xbf\xbf",
+		// Surrogates, and past U+10FFFF.
+		"\xed\xa0\x80", "\xed\xbf\xbf", "\xf4\x90\x80\x80", "\xf5\x80\x80\x80",
+		"\xf8\x88\x80\x80\x80", "\xff", "\xfe",
+		// Truncated, and stray continuation bytes.
+		"\xc3", "\xe4\xb8", "\xf0\x9f\x98", "\x80", "\xbf", "a\x80z",
+		"\xe4\xb8\xad\xad", "\xc3\xa9\xc3",
+	};
+	for (size_t i = 0; i < sizeof(sequences) / sizeof(sequences[0]); ++i) {
+		for (size_t offset = 0; offset < 130; ++offset) {
+			checkString(sequences[i], offset);
+			checkString(std::string("abc") + sequences[i] + "def", offset);
+		}
+	}
+}
+
+static void testRandom() {
+	const unsigned char interesting[] = { 'a', ' ', 0x80, 0x8f, 0x90, 0xa0,
+			0xbf, 0xc0, 0xc2, 0xdf, 0xe0, 0xed, 0xef, 0xf0, 0xf4, 0xf5, 0xff };
+	for (int round = 0; round < 20000; ++round) {
+		std::string bytes;
+		size_t length = rand() % 12;
+		for (size_t i = 0; i < length; ++i) {
+			bytes += char(interesting[rand() % sizeof(interesting)]);
+		}
+		checkString(bytes, rand() % 70);
+	}
+}
+
+/// Bytes outside strings, and where the error is located.
+static void testErrors() {
+	Reader reader;
+	reader.setStrictUtf8(true);
+	Value root;
+	CHECK(!reader.parse("[\"ab\xc0\x80\"]", root));
+	CHECK(reader.getFormattedErrorMessages().find("Line 1, Column 5")
+			!= std::string::npos);
+	CHECK(!reader.parse("[1,\n \"\xed\xa0\x80\"]", root));
+	CHECK(reader.getFormattedErrorMessages().find("Line 2, Column 3")
+			!= std::string::npos);
+	CHECK(!reader.parse("[1] \xff", root));
+	CHECK(reader.parse("{\"\xc3\xa9t\xc3\xa9\":\"\\u00e9\"}", root));
+
+	// The lenient reader takes the bytes as they are.
+	reader.setStrictUtf8(false);
+	CHECK(reader.parse("[\"\xc0\x80\xff\"]", root));
+	CHECK(root[0u].asString() == "\xc0\x80\xff");
+}
+
+int main() {
+	testSequences();
+	testRandom();
+	testErrors();
+	return testResult("test_utf8");
+}
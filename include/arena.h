@@ -0,0 +1,115 @@
+/*
+ * arena.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef ARENA_H_INCLUDE_MINI_JSONCPP_
+#define ARENA_H_INCLUDE_MINI_JSONCPP_
+
+#include "config.h"
+
+namespace Json {
+
+/** \brief Monotonic memory: allocations bump a pointer in large blocks and
+ * are only given back all at once, by clear() or the destructor.
+ */
+class Arena {
+public:
+	Arena();
+	~Arena();
+
+	void* allocate(size_t size, size_t alignment);
+
+	/// Free every allocation; the first block is kept for reuse.
+	void clear();
+
+	/// Bytes handed out since the last clear().
+	size_t used() const;
+
+private:
+	Arena(const Arena&);
+	Arena& operator=(const Arena&);
+
+	void* allocateBlock(size_t size, size_t alignment);
+
+	struct Block {
+		Block* next_;
+		size_t size_;
+	};
+
+	Block* blocks_;
+	char* current_;
+	char* end_;
+	size_t used_;
+};
+
+/** \brief Allocator of the Value containers: from an Arena when it has one,
+ * from the heap otherwise.
+ *
+ * Copies of a container never inherit the arena (see
+ * select_on_container_copy_construction()), so copying a Value out of an
+ * arena tree gives an independent heap tree.
+ */
+template<typename T>
+class ArenaAllocator {
+public:
+	typedef T value_type;
+	typedef std::false_type propagate_on_container_copy_assignment;
+	typedef std::false_type propagate_on_container_move_assignment;
+	typedef std::false_type propagate_on_container_swap;
+
+	template<typename U>
+	struct rebind {
+		typedef ArenaAllocator<U> other;
+	};
+
+	ArenaAllocator() :
+			arena_(NULL) {
+	}
+	explicit ArenaAllocator(Arena* arena) :
+			arena_(arena) {
+	}
+	template<typename U>
+	ArenaAllocator(const ArenaAllocator<U>& other) :
+			arena_(other.arena()) {
+	}
+
+	T* allocate(size_t count) {
+		if (arena_ != NULL) {
+			return static_cast<T*>(arena_->allocate(count * sizeof(T),
+					alignof(T)));
+		}
+		return static_cast<T*>(::operator new(count * sizeof(T)));
+	}
+	void deallocate(T* pointer, size_t count) {
+		if (arena_ == NULL) {
+			::operator delete(pointer);
+		}
+	}
+
+	ArenaAllocator select_on_container_copy_construction() const {
+		return ArenaAllocator();
+	}
+
+	Arena* arena() const {
+		return arena_;
+	}
+
+private:
+	Arena* arena_;
+};
+
+template<typename T, typename U>
+inline bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+	return a.arena() == b.arena();
+}
+
+template<typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+	return a.arena() != b.arena();
+}
+
+} // namespace Json
+
+#endif /* ARENA_H_INCLUDE_MINI_JSONCPP_ */
@@ -0,0 +1,419 @@
+/*
+ * bind.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef BIND_H_INCLUDE_MINI_JSONCPP_
+#define BIND_H_INCLUDE_MINI_JSONCPP_
+
+#include "reader.h"
+#include <limits>
+#include <type_traits>
+#if __cplusplus >= 201703L
+#include <optional>
+#endif
+
+namespace Json {
+
+/** \brief Parse a document straight into C++ types, without a Value tree.
+ *
+ * The tokens of Reader are read into the fields of structs bound with
+ * JSON_BIND(), and into bool, integers, floating point numbers,
+ * std::string, Value, std::vector, std::map with string keys and
+ * std::optional. A type is read by the jsonRead() overload found for it,
+ * so other types are supported by adding one, written with the building
+ * blocks below.
+ *
+ * Members of the document without a field are skipped and fields without
+ * a member keep their value. A value of the wrong type, or an integer out
+ * of the range of its field, fails the parse with an error located in the
+ * document.
+ * \code
+ * Json::BindReader reader;
+ * Request request;
+ * if (!reader.parse(body, request)) {
+ *     std::cerr << reader.getFormattedErrorMessages();
+ * }
+ * \endcode
+ */
+class BindReader {
+public:
+	BindReader();
+
+	/** \brief Read the document into \c object, which is not reset first.
+	 *
+	 * The document is read in place, not copied; if the parse fails, it is
+	 * copied for getFormattedErrorMessages() to locate the errors.
+	 */
+	template<typename T>
+	bool parse(const std::string& document, T& object) {
+		return parse(document.data(), document.data() + document.length(),
+				object);
+	}
+
+	template<typename T>
+	bool parse(const char* beginDoc, const char* endDoc, T& object) {
+		return finish(start(beginDoc, endDoc) && jsonRead(*this, object));
+	}
+
+	/// Errors in the format of Reader::getFormattedErrorMessages().
+	std::string getFormattedErrorMessages() const;
+
+	std::vector<std::string> getStructuredErrors() const;
+
+	bool good() const;
+
+	// Building blocks of the jsonRead() overloads: each reads the next
+	// value, or part of a container, and returns \c false on an error.
+
+	bool read(bool& value);
+	/// An integer token in [minimum, maximum].
+	bool read(Int64& value, Int64 minimum, Int64 maximum);
+	bool read(UInt64& value, UInt64 maximum);
+	bool read(double& value);
+	bool read(std::string& value);
+	/// Any value, built as by Reader::parse().
+	bool read(Value& value);
+
+	/// \c true if the next value is null, which is then read.
+	bool readNull();
+
+	/// Skip the next value.
+	bool skipValue();
+
+	/// Read the '{' starting an object.
+	bool startObject();
+
+	/** \brief Move to the next member of the object.
+	 * \param count Members read so far, 0 after startObject(); incremented.
+	 * \return \c false after the last member or on an error, good() tells
+	 *         which. The value of the member is read next.
+	 */
+	bool nextMember(ArrayIndex& count);
+
+	/// Name of the member nextMember() moved to.
+	const std::string& memberName() const;
+
+	/// Read the '[' starting an array.
+	bool startArray();
+
+	/// Same as nextMember() for the elements of an array.
+	bool nextElement(ArrayIndex& count);
+
+private:
+	BindReader(const BindReader&);
+	BindReader& operator=(const BindReader&);
+
+	bool start(const char* beginDoc, const char* endDoc);
+	bool finish(bool successful);
+	bool startContainer(Reader::TokenType type, const char* message);
+	bool readNumber(Reader::Token& token, NumberParts& number);
+	bool addError(const std::string& message, Reader::Token& token);
+
+	Reader reader_;
+	std::string name_;
+	/// Containers open, limited by the stack limit of the reader.
+	unsigned int depth_;
+};
+
+/** \brief Write C++ types as a document, without a Value tree.
+ *
+ * The counterpart of BindReader: values are appended to the document
+ * with the jsonWrite() overload found for their type, in the format of
+ * FastWriter without the ending line feed.
+ * \code
+ * std::string body;
+ * Json::BindWriter writer(body);
+ * writer.write(response);
+ * \endcode
+ */
+class BindWriter {
+public:
+	/// Append to \c document.
+	explicit BindWriter(std::string& document);
+
+	template<typename T>
+	void write(const T& object) {
+		jsonWrite(*this, object);
+	}
+
+	// Building blocks of the jsonWrite() overloads.
+
+	void null();
+	void value(bool value);
+	void value(Int64 value);
+	void value(UInt64 value);
+	void value(double value);
+	void value(const char* value, size_t length);
+	void value(const Value& value);
+
+	void startObject();
+	/// Name of the next member, its value follows.
+	void key(const char* name, size_t length);
+	void endObject();
+
+	void startArray();
+	void endArray();
+
+private:
+	BindWriter(const BindWriter&);
+	BindWriter& operator=(const BindWriter&);
+
+	void separate();
+
+	std::string& document_;
+	/// A value was written: the next one needs a ','.
+	bool comma_;
+};
+
+// jsonRead() and jsonWrite() of the supported types
+// //////////////////////////////////////////////////////////////////
+
+inline bool jsonRead(BindReader& reader, bool& value) {
+	return reader.read(value);
+}
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value,
+		bool>::type jsonRead(BindReader& reader, T& value) {
+	Int64 read;
+	if (!reader.read(read, std::numeric_limits<T>::min(),
+			std::numeric_limits<T>::max())) {
+		return false;
+	}
+	value = T(read);
+	return true;
+}
+
+template<typename T>
+typename std::enable_if<
+		std::is_integral<T>::value && !std::is_signed<T>::value
+				&& !std::is_same<T, bool>::value, bool>::type jsonRead(
+		BindReader& reader, T& value) {
+	UInt64 read;
+	if (!reader.read(read, std::numeric_limits<T>::max())) {
+		return false;
+	}
+	value = T(read);
+	return true;
+}
+
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value, bool>::type jsonRead(
+		BindReader& reader, T& value) {
+	double read;
+	if (!reader.read(read)) {
+		return false;
+	}
+	value = T(read);
+	return true;
+}
+
+inline bool jsonRead(BindReader& reader, std::string& value) {
+	return reader.read(value);
+}
+
+inline bool jsonRead(BindReader& reader, Value& value) {
+	return reader.read(value);
+}
+
+template<typename T>
+bool jsonRead(BindReader& reader, std::vector<T>& values) {
+	if (!reader.startArray()) {
+		return false;
+	}
+	values.clear();
+	ArrayIndex count = 0;
+	while (reader.nextElement(count)) {
+		values.resize(values.size() + 1);
+		if (!jsonRead(reader, values.back())) {
+			return false;
+		}
+	}
+	return reader.good();
+}
+
+template<typename T>
+bool jsonRead(BindReader& reader, std::map<std::string, T>& values) {
+	if (!reader.startObject()) {
+		return false;
+	}
+	values.clear();
+	ArrayIndex count = 0;
+	while (reader.nextMember(count)) {
+		if (!jsonRead(reader, values[reader.memberName()])) {
+			return false;
+		}
+	}
+	return reader.good();
+}
+
+#if __cplusplus >= 201703L
+/// null, or a missing member, leaves the optional empty.
+template<typename T>
+bool jsonRead(BindReader& reader, std::optional<T>& value) {
+	if (reader.readNull()) {
+		value.reset();
+		return true;
+	}
+	return jsonRead(reader, value.emplace());
+}
+#endif
+
+inline void jsonWrite(BindWriter& writer, bool value) {
+	writer.value(value);
+}
+
+template<typename T>
+typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type jsonWrite(
+		BindWriter& writer, T value) {
+	writer.value(Int64(value));
+}
+
+template<typename T>
+typename std::enable_if<
+		std::is_integral<T>::value && !std::is_signed<T>::value
+				&& !std::is_same<T, bool>::value>::type jsonWrite(
+		BindWriter& writer, T value) {
+	writer.value(UInt64(value));
+}
+
+template<typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type jsonWrite(
+		BindWriter& writer, T value) {
+	writer.value(double(value));
+}
+
+inline void jsonWrite(BindWriter& writer, const std::string& value) {
+	writer.value(value.data(), value.length());
+}
+
+inline void jsonWrite(BindWriter& writer, const Value& value) {
+	writer.value(value);
+}
+
+template<typename T>
+void jsonWrite(BindWriter& writer, const std::vector<T>& values) {
+	writer.startArray();
+	for (typename std::vector<T>::const_iterator it = values.begin();
+			it != values.end(); ++it) {
+		jsonWrite(writer, *it);
+	}
+	writer.endArray();
+}
+
+template<typename T>
+void jsonWrite(BindWriter& writer, const std::map<std::string, T>& values) {
+	writer.startObject();
+	for (typename std::map<std::string, T>::const_iterator it = values.begin();
+			it != values.end(); ++it) {
+		writer.key(it->first.data(), it->first.length());
+		jsonWrite(writer, it->second);
+	}
+	writer.endObject();
+}
+
+#if __cplusplus >= 201703L
+template<typename T>
+void jsonWrite(BindWriter& writer, const std::optional<T>& value) {
+	if (value) {
+		jsonWrite(writer, *value);
+	} else {
+		writer.null();
+	}
+}
+#endif
+
+} // namespace Json
+
+/** \brief Bind the members of a struct to the members of a JSON object.
+ *
+ * Defines jsonRead() and jsonWrite() for \c Type, which BindReader and
+ * BindWriter then use for it and for containers of it. Use it at namespace
+ * scope in the namespace of \c Type, after the bound types of its fields,
+ * with the names of up to 32 public fields; each is read from and written
+ * to the member of the same name.
+ * \code
+ * struct Point {
+ *     int x;
+ *     int y;
+ * };
+ * JSON_BIND(Point, x, y)
+ * \endcode
+ */
+#define JSON_BIND(Type, ...) \
+	inline bool jsonRead(::Json::BindReader& reader_, Type& object_) { \
+		if (!reader_.startObject()) { \
+			return false; \
+		} \
+		::Json::ArrayIndex count_ = 0; \
+		while (reader_.nextMember(count_)) { \
+			const std::string& name_ = reader_.memberName(); \
+			if (false) { \
+			} JSON_BIND_EACH(JSON_BIND_READ, __VA_ARGS__) else if (!reader_.skipValue()) { \
+				return false; \
+			} \
+		} \
+		return reader_.good(); \
+	} \
+	inline void jsonWrite(::Json::BindWriter& writer_, const Type& object_) { \
+		writer_.startObject(); \
+		JSON_BIND_EACH(JSON_BIND_WRITE, __VA_ARGS__) \
+		writer_.endObject(); \
+	}
+
+#define JSON_BIND_READ(field) \
+	else if (name_ == #field) { \
+		if (!jsonRead(reader_, object_.field)) { \
+			return false; \
+		} \
+	}
+
+#define JSON_BIND_WRITE(field) \
+	writer_.key(#field, sizeof(#field) - 1); \
+	jsonWrite(writer_, object_.field);
+
+// Apply m to each of up to 32 arguments.
+#define JSON_BIND_EXPAND(x) x
+#define JSON_BIND_CAT(a, b) JSON_BIND_CAT_(a, b)
+#define JSON_BIND_CAT_(a, b) a##b
+#define JSON_BIND_COUNT(...) \
+	JSON_BIND_EXPAND(JSON_BIND_COUNT_(__VA_ARGS__, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0))
+#define JSON_BIND_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, count, ...) count
+#define JSON_BIND_EACH(m, ...) \
+	JSON_BIND_EXPAND(JSON_BIND_CAT(JSON_BIND_EACH_, JSON_BIND_COUNT(__VA_ARGS__))(m, __VA_ARGS__))
+#define JSON_BIND_EACH_1(m, field) m(field)
+#define JSON_BIND_EACH_2(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_1(m, __VA_ARGS__))
+#define JSON_BIND_EACH_3(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_2(m, __VA_ARGS__))
+#define JSON_BIND_EACH_4(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_3(m, __VA_ARGS__))
+#define JSON_BIND_EACH_5(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_4(m, __VA_ARGS__))
+#define JSON_BIND_EACH_6(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_5(m, __VA_ARGS__))
+#define JSON_BIND_EACH_7(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_6(m, __VA_ARGS__))
+#define JSON_BIND_EACH_8(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_7(m, __VA_ARGS__))
+#define JSON_BIND_EACH_9(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_8(m, __VA_ARGS__))
+#define JSON_BIND_EACH_10(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_9(m, __VA_ARGS__))
+#define JSON_BIND_EACH_11(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_10(m, __VA_ARGS__))
+#define JSON_BIND_EACH_12(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_11(m, __VA_ARGS__))
+#define JSON_BIND_EACH_13(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_12(m, __VA_ARGS__))
+#define JSON_BIND_EACH_14(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_13(m, __VA_ARGS__))
+#define JSON_BIND_EACH_15(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_14(m, __VA_ARGS__))
+#define JSON_BIND_EACH_16(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_15(m, __VA_ARGS__))
+#define JSON_BIND_EACH_17(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_16(m, __VA_ARGS__))
+#define JSON_BIND_EACH_18(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_17(m, __VA_ARGS__))
+#define JSON_BIND_EACH_19(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_18(m, __VA_ARGS__))
+#define JSON_BIND_EACH_20(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_19(m, __VA_ARGS__))
+#define JSON_BIND_EACH_21(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_20(m, __VA_ARGS__))
+#define JSON_BIND_EACH_22(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_21(m, __VA_ARGS__))
+#define JSON_BIND_EACH_23(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_22(m, __VA_ARGS__))
+#define JSON_BIND_EACH_24(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_23(m, __VA_ARGS__))
+#define JSON_BIND_EACH_25(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_24(m, __VA_ARGS__))
+#define JSON_BIND_EACH_26(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_25(m, __VA_ARGS__))
+#define JSON_BIND_EACH_27(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_26(m, __VA_ARGS__))
+#define JSON_BIND_EACH_28(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_27(m, __VA_ARGS__))
+#define JSON_BIND_EACH_29(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_28(m, __VA_ARGS__))
+#define JSON_BIND_EACH_30(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_29(m, __VA_ARGS__))
+#define JSON_BIND_EACH_31(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_30(m, __VA_ARGS__))
+#define JSON_BIND_EACH_32(m, field, ...) m(field) JSON_BIND_EXPAND(JSON_BIND_EACH_31(m, __VA_ARGS__))
+
+#endif /* BIND_H_INCLUDE_MINI_JSONCPP_ */
@@ -40,6 +40,16 @@ using namespace std;
 #define JSONCPP_DEPRECATED(message)
 #endif
 
+/*
+ * Build with -DJSON_READER_STATS to have Reader count what it reads, see
+ * ReaderStats. Without it the counting is compiled out and the statistics
+ * stay zero.
+ *
+ * Build with -DJSON_MAP_OBJECTS, the library and its users alike, to keep
+ * object members in a std::map sorted by name instead of an ObjectTable
+ * in insertion order.
+ */
+
 #ifndef LOG
 #define LOG(X, Y...) do  { printf("%s:%s:%d" X "\n",__FILE__, __FUNCTION__, __LINE__, ##Y); } while(0)
 #endif
@@ -71,11 +81,37 @@ class StyledWriter;
 
 // reader.h
 class Reader;
+class ReaderStats;
+
+// handler.h
+class Handler;
 
 // value.h
 typedef unsigned int ArrayIndex;
 class Value;
 
+// arena.h
+class Arena;
+
+// document.h
+class Document;
+
+// selection.h
+class Selection;
+class KeyFilter;
+
+// key.h
+class Key;
+class KeyTable;
+
+// bind.h
+class BindReader;
+class BindWriter;
+
+// object_table.h
+class ObjectMember;
+class ObjectTable;
+
 } // end namespace Json
 
 #endif /* CONFIG_H_INCLUDE_MINI_JSONCPP_ */
@@ -0,0 +1,57 @@
+/*
+ * document.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef DOCUMENT_H_INCLUDE_MINI_JSONCPP_
+#define DOCUMENT_H_INCLUDE_MINI_JSONCPP_
+
+#include "value.h"
+
+namespace Json {
+
+/** \brief A parsed Value tree whose nodes all live in one Arena.
+ *
+ * Reader::parse(const std::string&, Document&) allocates every string,
+ * array, object and map node of the tree from the document's arena, so
+ * parsing costs a few large allocations and destroying the document, or
+ * clear(), frees the whole tree at once without visiting it.
+ *
+ * The tree is read through the usual const Value API. It must not be
+ * modified: copy a subtree out to change it, the copy is an ordinary heap
+ * Value independent of the document.
+ * \code
+ * Json::Document document;
+ * if (reader.parse(text, document)) {
+ *     int id = document.root()["user"]["id"].asInt();
+ *     Json::Value editable = document.root()["events"];
+ * }
+ * \endcode
+ */
+class Document {
+public:
+	Document();
+
+	const Value& root() const;
+
+	/// Free the tree, in O(1) with respect to its size.
+	void clear();
+
+	/// Bytes of the arena holding the tree.
+	size_t memoryUsed() const;
+
+private:
+	friend class Reader;
+
+	Document(const Document&);
+	Document& operator=(const Document&);
+
+	// Declared first to outlive root_.
+	Arena arena_;
+	Value root_;
+};
+
+} // namespace Json
+
+#endif /* DOCUMENT_H_INCLUDE_MINI_JSONCPP_ */
@@ -0,0 +1,95 @@
+/*
+ * gzip_reader.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef GZIP_READER_H_INCLUDE_MINI_JSONCPP_
+#define GZIP_READER_H_INCLUDE_MINI_JSONCPP_
+
+#include "push_reader.h"
+
+struct z_stream_s;
+
+namespace Json {
+
+/** \brief Parse a gzip or zlib compressed document as it is inflated.
+ *
+ * Compressed bytes are pushed with feed(), or read from a file by
+ * parseFile(); they are inflated a bounded chunk at a time into a
+ * PushReader, so neither the compressed nor the decompressed document is
+ * ever held whole. The format is detected from the header, and
+ * concatenated gzip members are read as one stream, like gzip -d does.
+ *
+ * Parsing behaves as PushReader on the decompressed bytes. Corrupt or
+ * truncated compressed input is reported as an error as well.
+ * \code
+ * Json::Value root;
+ * Json::GzipReader reader(root);
+ * if (!reader.parseFile("events.json.gz")) {
+ *     std::cerr << reader.getFormattedErrorMessages();
+ * }
+ * \endcode
+ */
+class GzipReader {
+public:
+	/// Report the document to \c handler as a stream of events.
+	explicit GzipReader(Handler& handler);
+
+	/// Build the document into \c root.
+	explicit GzipReader(Value& root);
+
+	~GzipReader();
+
+	/** \brief Inflate and parse the next \c length compressed bytes.
+	 * \return \c false once an error occurred, further input is ignored.
+	 */
+	bool feed(const char* data, size_t length);
+
+	/// Same as feed(const char*, size_t) on the bytes of \c data.
+	bool feed(const std::string& data);
+
+	/** \brief Signal the end of the compressed input.
+	 * \return \c true if the whole document was successfully parsed.
+	 */
+	bool finish();
+
+	/// Feed the whole file at \c path, then finish().
+	bool parseFile(const std::string& path);
+
+	/// Forget the current document to parse a new one with the same output.
+	void reset();
+
+	/// See PushReader::setStackLimit(); the default is 1000.
+	void setStackLimit(unsigned int limit);
+
+	unsigned int stackLimit() const;
+
+	/// Errors in the format of Reader::getFormattedErrorMessages().
+	std::string getFormattedErrorMessages() const;
+
+	std::vector<std::string> getStructuredErrors() const;
+
+	/// \c true if no error occurred so far.
+	bool good() const;
+
+private:
+	GzipReader(const GzipReader&);
+	GzipReader& operator=(const GzipReader&);
+
+	void start();
+	bool addError(const std::string& message);
+
+	PushReader reader_;
+	z_stream_s* stream_;
+	std::vector<char> output_;
+	/// Compression error, located by its offset in the compressed input.
+	std::string error_;
+	size_t errorOffset_;
+	/// The current gzip member, or zlib stream, is complete.
+	bool ended_;
+};
+
+} // namespace Json
+
+#endif /* GZIP_READER_H_INCLUDE_MINI_JSONCPP_ */
@@ -0,0 +1,85 @@
+/*
+ * handler.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef HANDLER_H_INCLUDE_MINI_JSONCPP_
+#define HANDLER_H_INCLUDE_MINI_JSONCPP_
+
+#include "config.h"
+
+namespace Json {
+
+/** \brief Receives the events of a document parsed without building a Value.
+ *
+ * Pass an instance to Reader::parse() to consume a document as a stream of
+ * events (SAX style). Every method returns \c true to continue; returning
+ * \c false stops the parse, which then fails with an error.
+ *
+ * All methods do nothing by default, so a handler only overrides the events
+ * it cares about.
+ *
+ * Strings and keys are passed as a pointer and length, they may contain
+ * embedded zeroes and are only valid during the call. Integers are reported
+ * the way Value would store them: intValue through int64(), uintValue through
+ * uint64(), everything else through real().
+ */
+class Handler {
+public:
+	virtual ~Handler();
+
+	virtual bool null();
+	virtual bool boolean(bool value);
+	virtual bool int64(Int64 value);
+	virtual bool uint64(UInt64 value);
+	virtual bool real(double value);
+	virtual bool string(const char* value, size_t length);
+
+	virtual bool startObject();
+	/// Name of the next object member, its value follows.
+	virtual bool key(const char* name, size_t length);
+	virtual bool endObject();
+
+	virtual bool startArray();
+	virtual bool endArray();
+};
+
+/** \brief A Handler that builds a Value from the events it receives.
+ *
+ * The first value received replaces \c root; containers are filled the way
+ * Reader::parse(const std::string&, Value&) fills them.
+ */
+class ValueBuilder: public Handler {
+public:
+	explicit ValueBuilder(Value& root);
+
+	/// Forget the containers being filled, to build a new document.
+	void reset();
+
+	virtual bool null();
+	virtual bool boolean(bool value);
+	virtual bool int64(Int64 value);
+	virtual bool uint64(UInt64 value);
+	virtual bool real(double value);
+	virtual bool string(const char* value, size_t length);
+
+	virtual bool startObject();
+	virtual bool key(const char* name, size_t length);
+	virtual bool endObject();
+
+	virtual bool startArray();
+	virtual bool endArray();
+
+private:
+	Value& next();
+	bool set(Value&& value);
+
+	Value& root_;
+	std::vector<Value*> nodes_;
+	std::string key_;
+};
+
+} // namespace Json
+
+#endif /* HANDLER_H_INCLUDE_MINI_JSONCPP_ */
@@ -0,0 +1,123 @@
+/*
+ * indexer.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef INDEXER_H_INCLUDE_MINI_JSONCPP_
+#define INDEXER_H_INCLUDE_MINI_JSONCPP_
+
+#include "config.h"
+
+namespace Json {
+
+/** \brief Stage one of the two-stage parser: a structural index of a document.
+ *
+ * The document is scanned in 64 byte blocks. For every block a classifier
+ * builds bitmaps of quotes, backslashes, whitespace and the structural
+ * characters <tt>{ } [ ] : ,</tt>; escapes and string ranges are then
+ * resolved with branch-free bit arithmetic and the offset of every
+ * interesting byte is appended to the index:
+ * - structural characters outside of strings,
+ * - every unescaped quote (so each string is an opening/closing pair),
+ * - the first byte of any other token (numbers, literals, stray bytes).
+ *
+ * Stage two (Reader) walks the index to jump over whitespace runs and
+ * string bodies instead of stepping through them one char at a time.
+ *
+ * The index is built a stretch of the document at a time, as stage two
+ * asks for more, into a window of at most windowEntries offsets allocated
+ * once: its memory does not grow with the document. A window that is full
+ * is emptied before the next stretch is indexed.
+ *
+ * The document can be validated as UTF-8 first: a pass over its 64 byte
+ * blocks accepts pure ASCII ones with one test and only checks the bytes
+ * of multi-byte sequences one by one.
+ *
+ * The classifier is picked once at runtime: AVX2 or SSE4.2 where the CPU
+ * supports them, a portable scalar version otherwise.
+ */
+class StructuralIndex {
+public:
+	typedef unsigned int Offset;
+
+	/// invalidUtf8() of a valid, or unchecked, document.
+	static const size_t npos = size_t(-1);
+
+	/// Capacity of the window, in offsets.
+	static const size_t windowEntries = 256 * 1024;
+
+	StructuralIndex();
+	StructuralIndex(const StructuralIndex& other);
+	StructuralIndex& operator=(const StructuralIndex& other);
+	~StructuralIndex();
+
+	/** \brief Start indexing the document [begin, end), which must outlive
+	 * the index, and index its first stretch.
+	 * \param validateUtf8 Also check the document is well-formed UTF-8, see
+	 *        invalidUtf8(); documents too large to index are still checked.
+	 * \return \c false if the document is too large for 32 bit offsets, in
+	 *         which case the index is left empty.
+	 */
+	bool build(const char* begin, const char* end, bool validateUtf8 = false);
+
+	/** \brief Index the stretch of the document following the last one.
+	 *
+	 * The offsets are appended to the window, which is emptied first if they
+	 * might not fit: pointers into it are then invalid.
+	 * \return the first offset appended, or NULL, leaving the window as it
+	 *         was, at the end of the document.
+	 */
+	const Offset* next();
+
+	/** \brief Empty the window and index again from \c offset.
+	 *
+	 * The byte at \c offset must be outside of any string and must not
+	 * continue a number or literal: whitespace, a structural character or
+	 * the first byte of a token.
+	 */
+	void restart(size_t offset);
+
+	/** \brief Offset of the first invalid UTF-8 sequence found by build().
+	 *
+	 * Overlong forms, encoded UTF-16 surrogates, code points above U+10FFFF,
+	 * stray continuation bytes and sequences cut short are invalid. npos if
+	 * there is none or the document was not checked.
+	 */
+	size_t invalidUtf8() const;
+
+	void clear();
+
+	/// The offsets in the window: those of the document bytes
+	/// [windowBegin(), windowEnd()).
+	size_t size() const;
+	const Offset* begin() const;
+	const Offset* end() const;
+	size_t windowBegin() const;
+	size_t windowEnd() const;
+
+	/// Name of the block classifier used on this machine.
+	static const char* implementation();
+
+private:
+	void index(size_t bytes);
+
+	const char* document_;
+	size_t length_;
+	/// capacity_ offsets, not initialised: only the first size_ are set.
+	Offset* offsets_;
+	size_t capacity_;
+	size_t size_;
+	size_t windowBegin_;
+	/// The first byte not indexed yet.
+	size_t scanned_;
+	/// What the last block indexed carries over to the next one.
+	unsigned long long prevEscaped_;
+	unsigned long long prevInString_;
+	unsigned long long prevScalar_;
+	size_t invalidUtf8_;
+};
+
+} // namespace Json
+
+#endif /* INDEXER_H_INCLUDE_MINI_JSONCPP_ */
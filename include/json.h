@@ -10,7 +10,16 @@
 
 #include "config.h"
 #include "value.h"
+#include "object_table.h"
+#include "key.h"
+#include "document.h"
+#include "selection.h"
 #include "reader.h"
+#include "push_reader.h"
+#include "gzip_reader.h"
+#include "lines_reader.h"
+#include "lazy.h"
+#include "bind.h"
 #include "writer.h"
 
 #endif /* JSON_H_INCLUDE_MINI_JSONCPP_ */
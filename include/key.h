@@ -0,0 +1,136 @@
+/*
+ * key.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef KEY_H_INCLUDE_MINI_JSONCPP_
+#define KEY_H_INCLUDE_MINI_JSONCPP_
+
+#include "config.h"
+#include "arena.h"
+#include <pthread.h>
+#include <unordered_set>
+
+namespace Json {
+
+class KeyTable;
+
+/** \brief The name of an object member, the key of Value::ObjectValues.
+ *
+ * Short names are stored in the key itself, longer ones on the heap or in
+ * the Arena of a Document. A key from a KeyTable only refers to the name
+ * of the table: every object using it shares the same bytes, and two such
+ * keys are found equal by comparing their pointers.
+ */
+class Key {
+public:
+	Key();
+	/// A copy of [data, data + length), long names allocated from \c arena.
+	Key(const char* data, size_t length, Arena* arena = NULL);
+	/// Copies own their bytes, except for keys of a KeyTable which share them.
+	Key(const Key& other);
+	/// Same as Key(const Key&), long names allocated from \c arena.
+	Key(const Key& other, Arena* arena);
+	Key& operator=(const Key& other);
+	~Key();
+
+	/// Exchange the names, whatever their storage, without copying bytes.
+	void swap(Key& other);
+
+	/// A key referring to [data, data + length) without copying it, for
+	/// lookups: it must not outlive the bytes.
+	static Key view(const char* data, size_t length);
+
+	const char* data() const {
+		return storage_ == storeInline ? inline_ : pointer_;
+	}
+	size_t length() const {
+		return length_;
+	}
+
+	bool operator<(const Key& other) const {
+		const char* mine = data();
+		const char* theirs = other.data();
+		if (mine != theirs) {
+			int diff = memcmp(mine, theirs, std::min(length_, other.length_));
+			if (diff != 0) {
+				return diff < 0;
+			}
+		}
+		return length_ < other.length_;
+	}
+	bool operator==(const Key& other) const {
+		return length_ == other.length_
+				&& (data() == other.data()
+						|| memcmp(data(), other.data(), length_) == 0);
+	}
+	bool operator!=(const Key& other) const {
+		return !(*this == other);
+	}
+
+private:
+	friend class KeyTable;
+
+	enum Storage {
+		/// In inline_.
+		storeInline,
+		/// Owned, on the heap.
+		storeHeap,
+		/// In an arena or a view: never freed by the key.
+		storeBorrowed,
+		/// A name of a KeyTable.
+		storeShared
+	};
+
+	static const size_t inlineLength = 16;
+
+	void assign(const char* data, size_t length, Arena* arena);
+	void release();
+
+	union {
+		const char* pointer_;
+		char inline_[inlineLength];
+	};
+	UInt length_ :30;
+	UInt storage_ :2;
+};
+
+/** \brief A table of member names shared by the documents parsed with it.
+ *
+ * Give a table to Reader::setKeyTable() and every member name read is
+ * looked up in it: objects store a reference to the table's copy of the
+ * name instead of a copy of their own. Documents repeating the same names
+ * then hold each name once, and comparing names of the table compares
+ * pointers.
+ *
+ * A table may be shared by readers on several threads. Names are never
+ * removed, and the table must outlive every Value parsed with it and the
+ * copies of those Values.
+ */
+class KeyTable {
+public:
+	KeyTable();
+	~KeyTable();
+
+	/// The key of the table for \c name, added if it is new.
+	Key intern(const std::string& name);
+
+	/// Number of distinct names in the table.
+	size_t size() const;
+
+private:
+	KeyTable(const KeyTable&);
+	KeyTable& operator=(const KeyTable&);
+
+	typedef std::unordered_set<std::string> Names;
+
+	static Key shared(const std::string& name);
+
+	Names names_;
+	mutable pthread_rwlock_t lock_;
+};
+
+} // namespace Json
+
+#endif /* KEY_H_INCLUDE_MINI_JSONCPP_ */
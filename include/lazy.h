@@ -0,0 +1,159 @@
+/*
+ * lazy.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef LAZY_H_INCLUDE_MINI_JSONCPP_
+#define LAZY_H_INCLUDE_MINI_JSONCPP_
+
+#include "reader.h"
+
+namespace Json {
+
+class LazyDocument;
+class LazyIterator;
+
+/** \brief A cursor on a value of a LazyDocument.
+ *
+ * Nothing is decoded until asked for: looking up a member or an element
+ * skips over the values before it in the raw bytes, and a scalar is only
+ * converted by the as...() methods, which behave like those of Value.
+ *
+ * A member or element that does not exist gives a null cursor, like the
+ * const operator[] of Value. Cursors stay valid as long as their document
+ * and its buffer.
+ */
+class LazyValue {
+public:
+	LazyValue();
+
+	ValueType type() const;
+	bool isNull() const;
+	bool isBool() const;
+	bool isNumeric() const;
+	bool isString() const;
+	bool isArray() const;
+	bool isObject() const;
+
+	/// Member named \c key, or a null cursor. If the name repeats, the last
+	/// member, as Reader::parse() keeps it.
+	LazyValue operator[](const char* key) const;
+	LazyValue operator[](const std::string& key) const;
+	/// Element \c index of an array, or a null cursor.
+	LazyValue operator[](ArrayIndex index) const;
+
+	bool isMember(const char* key) const;
+	/// Number of elements or members, found by skipping over all of them;
+	/// members whose name repeats are each counted.
+	ArrayIndex size() const;
+	/// Visit the elements or members in document order, repeated names
+	/// included.
+	LazyIterator iterate() const;
+
+	std::string asString() const;
+	Int asInt() const;
+	UInt asUInt() const;
+	Int64 asInt64() const;
+	UInt64 asUInt64() const;
+	double asDouble() const;
+	bool asBool() const;
+
+	/// Build the whole subtree as a Value.
+	Value toValue() const;
+
+private:
+	friend class LazyDocument;
+	friend class LazyIterator;
+
+	LazyValue(LazyDocument* document, const char* start);
+
+	LazyDocument* document_;
+	/// First byte of the value, NULL for a missing value.
+	const char* start_;
+};
+
+/** \brief Walks the elements of an array or the members of an object.
+ *
+ * \code
+ * Json::LazyIterator it = value.iterate();
+ * while (it.next()) {
+ *     std::cout << it.name() << ": " << it.value().asString() << "\n";
+ * }
+ * \endcode
+ */
+class LazyIterator {
+public:
+	/// Move to the next element or member, \c false past the last one.
+	bool next();
+	/// Name of the current member, empty for an array element.
+	const std::string& name() const;
+	LazyValue value() const;
+
+private:
+	friend class LazyValue;
+
+	LazyIterator(LazyDocument* document, const char* container);
+
+	LazyDocument* document_;
+	/// Where the next element or member starts, NULL at the end.
+	const char* next_;
+	bool object_;
+	std::string name_;
+	LazyValue value_;
+};
+
+/** \brief A document read on demand instead of into a Value tree.
+ *
+ * parse() only starts indexing the structural bytes of the document (see
+ * StructuralIndex) and checks its root is an object or an array; values are
+ * then found and decoded as the cursors from root() ask for them, with the
+ * tokenizer of Reader. No std::map or std::vector is allocated for the
+ * containers walked through.
+ *
+ * Only the parts of the document that are visited are checked: navigating
+ * through malformed bytes gives null cursors. A document, and the cursors
+ * on it, must not be used by several threads at once.
+ */
+class LazyDocument {
+public:
+	LazyDocument();
+
+	/// Parse a copy of \c document.
+	bool parse(const std::string& document);
+
+	/** \brief Parse a document borrowed from the caller, which must stay
+	 * alive and unmodified while the document or its cursors are used.
+	 */
+	bool parseBorrowed(const char* document, size_t length);
+
+	/// The root value, a null cursor if the last parse failed.
+	LazyValue root();
+
+	std::string getFormattedErrorMessages() const;
+
+	bool good() const;
+
+private:
+	friend class LazyValue;
+	friend class LazyIterator;
+
+	LazyDocument(const LazyDocument&);
+	LazyDocument& operator=(const LazyDocument&);
+
+	const char* open(const char* container);
+	const char* find(const char* object, const char* key, size_t length);
+	bool nextChild(const char*& next, bool object, std::string* name,
+			const char*& value);
+	bool decode(const char* value, Value& decoded);
+
+	Reader reader_;
+	std::string document_;
+	std::string error_;
+	std::string name_;
+	const char* root_;
+};
+
+} // namespace Json
+
+#endif /* LAZY_H_INCLUDE_MINI_JSONCPP_ */
@@ -0,0 +1,102 @@
+/*
+ * lines_reader.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef LINES_READER_H_INCLUDE_MINI_JSONCPP_
+#define LINES_READER_H_INCLUDE_MINI_JSONCPP_
+
+#include "reader.h"
+
+namespace Json {
+
+/** \brief Parse <a HREF="https://jsonlines.org">JSON Lines</a> input on
+ * several threads.
+ *
+ * The input holds one document per line. It is cut into batches of whole
+ * lines which a pool of worker threads parse with a Reader each, borrowing
+ * the input bytes (see Reader::parse(const char*, const char*, Value&)).
+ * Blank lines are skipped and a trailing '\\r' is ignored. Every record follows the rules of
+ * Reader::parse(const std::string&, Value&).
+ *
+ * A failed record does not stop the others: its errors are collected with
+ * their line and column in the whole input.
+ */
+class LinesReader {
+public:
+	/// Receives the records of parse(const char*, const char*, Consumer&).
+	class Consumer {
+	public:
+		virtual ~Consumer();
+
+		/** \brief Called once per successfully parsed record.
+		 *
+		 * Called from the worker threads, concurrently and in no particular
+		 * order: implementations must be thread safe and must not throw.
+		 * \param offset Offset of the record's first byte in the input.
+		 * \param value The record, which the consumer may swap out.
+		 */
+		virtual void record(size_t offset, Value& value) = 0;
+	};
+
+	/** \param threads Number of threads parsing records, the calling thread
+	 * included; 0 uses one per online CPU.
+	 */
+	explicit LinesReader(int threads = 0);
+
+	/** \brief Parse every record, in input order.
+	 * \param records [out] One Value per non blank line; a record that failed
+	 *                to parse is null.
+	 * \return \c true if all records were successfully parsed.
+	 */
+	bool parse(const char* beginDoc, const char* endDoc,
+			std::vector<Value>& records);
+
+	/// Same as parse(const char*, const char*, std::vector<Value>&) on \c document.
+	bool parse(const std::string& document, std::vector<Value>& records);
+
+	/** \brief Hand each record to \c consumer as soon as it is parsed.
+	 *
+	 * Faster than the ordered overload: records are neither kept nor
+	 * reordered.
+	 * \return \c true if all records were successfully parsed.
+	 */
+	bool parse(const char* beginDoc, const char* endDoc, Consumer& consumer);
+
+	/// Number of threads used by the next parse.
+	int threads() const;
+
+	/// Errors of all failed records, ordered by line.
+	std::string getFormattedErrorMessages() const;
+
+	std::vector<std::string> getStructuredErrors() const;
+
+	/// \c true if the last parse had no error.
+	bool good() const;
+
+private:
+	class ErrorInfo {
+	public:
+		size_t line_;
+		int column_;
+		std::string message_;
+	};
+
+	typedef std::vector<ErrorInfo> Errors;
+
+	class Batch;
+	class Job;
+
+	static void* work(void* job);
+	static void parseBatch(Reader& reader, Batch& batch, Job& job);
+	bool run(const char* beginDoc, const char* endDoc,
+			std::vector<Batch>& batches, Consumer* consumer);
+
+	Errors errors_;
+	int threads_;
+};
+
+} // namespace Json
+
+#endif /* LINES_READER_H_INCLUDE_MINI_JSONCPP_ */
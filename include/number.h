@@ -0,0 +1,84 @@
+/*
+ * number.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef NUMBER_H_INCLUDE_MINI_JSONCPP_
+#define NUMBER_H_INCLUDE_MINI_JSONCPP_
+
+#include "config.h"
+
+namespace Json {
+
+/** \brief A number token split into its parts by scanNumber().
+ *
+ * The value is <tt>mantissa_ * 10^exponent_</tt>, negated if negative_:
+ * mantissa_ holds the first 19 significant digits and truncated_ tells
+ * whether any non-zero digit was dropped.
+ */
+class NumberParts {
+public:
+	/// The token, and the end of the part convertDouble() converts.
+	const char* begin_;
+	const char* end_;
+	UInt64 mantissa_;
+	Int64 exponent_;
+	/// Magnitude of an integral token.
+	UInt64 integer_;
+	bool negative_;
+	bool truncated_;
+	bool anyDigit_;
+	/// The token is an optional '-' and digits, and integer_ holds their
+	/// value: it fits in 64 bits.
+	bool integral_;
+};
+
+/** \brief Split the number token at the start of [begin, end) in one pass.
+ *
+ * The token is <tt>-?digits[.digits][(e|E)[+-]digits]</tt>, any part
+ * possibly empty. Integer and fraction digits are converted eight at a time
+ * with SWAR arithmetic on 64 bit words, and integers of up to 20 digits
+ * are checked exactly against 2^64 - 1, so that deciding between an
+ * integer and a double needs no second look at the bytes.
+ * \return The end of the token.
+ */
+const char* scanNumber(const char* begin, const char* end,
+		NumberParts& number);
+
+/** \brief The end of the number token at the start of [begin, end), as
+ * scanNumber() finds it, without converting anything.
+ *
+ * Reader::readToken() only delimits numbers: those of skipped values are
+ * never converted.
+ */
+const char* skipNumber(const char* begin, const char* end);
+
+/** \brief The double closest to a number split by scanNumber().
+ * \param slowPath [out] If not NULL, set when the conversion needed the
+ *                  exact fallback.
+ * \return \c false if it has no mantissa digit.
+ */
+bool convertDouble(const NumberParts& number, double& value, bool* slowPath =
+		NULL);
+
+/** \brief Convert a number token to the closest double.
+ *
+ * Works directly on [begin, end), which does not need to be NUL terminated,
+ * and does not depend on the C locale. The result is correctly rounded:
+ * exact small values take the Clinger fast path, everything else goes
+ * through the Eisel-Lemire algorithm, and the rare inputs with more than 19
+ * significant digits that it cannot settle fall back to an exact
+ * conversion.
+ *
+ * Like strtod, the longest prefix of the form
+ * <tt>-?digits[.digits][(e|E)[+-]digits]</tt> is converted and the rest is
+ * ignored; at least one mantissa digit is required. Values too large for a
+ * double become infinity, values too small become zero.
+ * \return \c false if the token does not start with a number.
+ */
+bool parseDouble(const char* begin, const char* end, double& value);
+
+} // namespace Json
+
+#endif /* NUMBER_H_INCLUDE_MINI_JSONCPP_ */
@@ -0,0 +1,206 @@
+/*
+ * object_table.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef OBJECT_TABLE_H_INCLUDE_MINI_JSONCPP_
+#define OBJECT_TABLE_H_INCLUDE_MINI_JSONCPP_
+
+#include "value.h"
+
+namespace Json {
+
+/// A member of an ObjectTable, named like the pairs of a std::map.
+class ObjectMember {
+public:
+	/// Long names are allocated from \c arena, see Key.
+	ObjectMember(const Key& name, Arena* arena) :
+			first(name, arena) {
+	}
+
+	Key first;
+	Value second;
+};
+
+/** \brief The members of an object value, in the order they were added.
+ *
+ * Members are allocated in blocks and never move: as with std::map,
+ * references to a member stay valid until it is removed, whatever is added
+ * or removed around it. An array of pointers to them, which growing
+ * reallocates, keeps their order; iterators point into it, so adding
+ * members invalidates them. Each growth allocates the new members and the
+ * new array together, once.
+ *
+ * Small objects, the most common, are searched linearly: comparing the
+ * lengths of the names first rejects most members without touching their
+ * bytes, and the object allocates nothing else. Past smallSize members, a
+ * separate open-addressing table of their hashes, probed linearly, finds
+ * them by name. Iterating visits the members in insertion order, so a
+ * document read and written back keeps the order of its members.
+ *
+ * The interface is the part of std::map Value uses, so that building with
+ * JSON_MAP_OBJECTS can swap it back for one.
+ */
+class ObjectTable {
+public:
+	/// Iterates over the member pointers of an ObjectTable, yielding
+	/// members: \c Member is ObjectMember or const ObjectMember.
+	template<typename Member>
+	class Iterator {
+	public:
+		explicit Iterator(ObjectMember* const * position = NULL) :
+				position_(position) {
+		}
+		/// An iterator converts to a const_iterator.
+		Iterator(const Iterator<ObjectMember>& other) :
+				position_(other.position_) {
+		}
+
+		Member& operator*() const {
+			return **position_;
+		}
+		Member* operator->() const {
+			return *position_;
+		}
+		Iterator& operator++() {
+			++position_;
+			return *this;
+		}
+		Iterator operator++(int) {
+			Iterator old(*this);
+			++position_;
+			return old;
+		}
+		bool operator==(const Iterator& other) const {
+			return position_ == other.position_;
+		}
+		bool operator!=(const Iterator& other) const {
+			return position_ != other.position_;
+		}
+
+	private:
+		friend class ObjectTable;
+		friend class Iterator<const ObjectMember>;
+
+		ObjectMember* const * position_;
+	};
+
+	typedef ObjectMember value_type;
+	typedef ArenaAllocator<ObjectMember> allocator_type;
+	typedef Iterator<ObjectMember> iterator;
+	typedef Iterator<const ObjectMember> const_iterator;
+
+	explicit ObjectTable(const allocator_type& allocator = allocator_type());
+	/// Copies are allocated from the heap, see ArenaAllocator.
+	ObjectTable(const ObjectTable& other);
+	ObjectTable& operator=(const ObjectTable& other);
+	~ObjectTable();
+
+	allocator_type get_allocator() const {
+		return allocator_;
+	}
+
+	size_t size() const {
+		return size_;
+	}
+	bool empty() const {
+		return size_ == 0;
+	}
+
+	iterator begin() {
+		return iterator(members_);
+	}
+	iterator end() {
+		return iterator(members_ + size_);
+	}
+	const_iterator begin() const {
+		return const_iterator(members_);
+	}
+	const_iterator end() const {
+		return const_iterator(members_ + size_);
+	}
+
+	iterator find(const Key& key);
+	const_iterator find(const Key& key) const;
+
+	/// The member named \c key, added with a null value if missing. Long
+	/// names are copied into the arena of the table, if it has one.
+	Value& operator[](const Key& key);
+	/// Same as operator[](), also telling whether the member was added.
+	std::pair<iterator, bool> try_emplace(const Key& key);
+
+	/// Remove the member at \c position; the following ones take its place
+	/// in the order. Costs a pass over the slots, without hashing, unless
+	/// it is the last member. \return the member that follows it.
+	iterator erase(iterator position);
+
+	void clear();
+
+	/// Make room for \c count members.
+	void reserve(size_t count);
+
+	/** \brief The member named \c key, moved to position \c claimed.
+	 *
+	 * Used by Reader::setRecycling() to read a document into an object of
+	 * the previous one: members read again are claimed one after the other,
+	 * so that they end up first and in the order of the new document.
+	 * Claiming a member twice returns it where it is.
+	 */
+	Value& claim(const Key& key, size_t& claimed);
+
+	/// Drop every member from position \c count on.
+	void truncate(size_t count);
+
+	/// The same members with equal values, in any order.
+	bool operator==(const ObjectTable& other) const;
+	/// Compare the members sorted by name, as std::map does.
+	bool operator<(const ObjectTable& other) const;
+
+private:
+	/// Starts each allocation of members, which follow it.
+	struct Block {
+		Block* next_;
+		/// Size of the allocation, in members.
+		size_t size_;
+	};
+
+	struct Slot {
+		/// Hash of the member name.
+		UInt hash_;
+		/// Position of the member plus one, 0 for an empty slot.
+		UInt member_;
+	};
+	typedef ArenaAllocator<Slot> SlotAllocator;
+
+	/// Capacity of the first allocation.
+	static const size_t minimumCapacity = 4;
+	/// Objects of up to smallSize members have no slots.
+	static const size_t smallSize = 8;
+
+	size_t lookup(const Key& key, UInt& hash) const;
+	ObjectMember& append(const Key& key, UInt hash);
+	void createSlots();
+	void insertSlot(UInt hash, size_t member);
+	Slot& slotOf(size_t position);
+	void removeSlot(size_t position);
+	void swapMembers(size_t a, size_t b);
+	void rehash();
+
+	allocator_type allocator_;
+	/// Every allocation, the last one first.
+	Block* blocks_;
+	/// capacity_ pointers to members: the first size_ in order, the others
+	/// to storage not yet used or freed by removing members.
+	ObjectMember** members_;
+	/// Twice as many slots as capacity_, a power of two; NULL until the
+	/// object grows past smallSize members.
+	Slot* slots_;
+	size_t size_;
+	size_t capacity_;
+	size_t mask_;
+};
+
+} // namespace Json
+
+#endif /* OBJECT_TABLE_H_INCLUDE_MINI_JSONCPP_ */
@@ -0,0 +1,163 @@
+/*
+ * push_reader.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef PUSH_READER_H_INCLUDE_MINI_JSONCPP_
+#define PUSH_READER_H_INCLUDE_MINI_JSONCPP_
+
+#include "reader.h"
+
+namespace Json {
+
+/** \brief Parse a document delivered in chunks, as it arrives.
+ *
+ * Bytes are pushed with feed() in pieces of any size and finish() marks the
+ * end of the input. Tokens may be split anywhere, including in the middle
+ * of a string, an escape sequence or a number: only the token being read is
+ * buffered, never the document.
+ *
+ * The grammar, the root requirement, the nesting limit and the error
+ * messages are those of Reader::parse(const std::string&, Value&). The
+ * output is a stream of Handler events, or a Value when constructed from
+ * one. Like Reader, the parse stops at the first error and bytes following
+ * the root value are ignored.
+ *
+ * \code
+ * Json::Value root;
+ * Json::PushReader reader(root);
+ * while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+ *     if (!reader.feed(buffer, n)) break;
+ * }
+ * if (!reader.finish()) {
+ *     std::cerr << reader.getFormattedErrorMessages();
+ * }
+ * \endcode
+ */
+class PushReader {
+public:
+	/// Report the document to \c handler as a stream of events.
+	explicit PushReader(Handler& handler);
+
+	/// Build the document into \c root.
+	explicit PushReader(Value& root);
+
+	~PushReader();
+
+	/** \brief Parse the next \c length bytes of the document.
+	 * \return \c false once an error occurred, further input is ignored.
+	 */
+	bool feed(const char* data, size_t length);
+
+	/// Same as feed(const char*, size_t) on the bytes of \c data.
+	bool feed(const std::string& data);
+
+	/** \brief Signal the end of the input.
+	 *
+	 * Completes a number still being read and checks the root value is
+	 * complete.
+	 * \return \c true if the whole document was successfully parsed.
+	 */
+	bool finish();
+
+	/// Forget the current document to parse a new one with the same output.
+	void reset();
+
+	/// \c true once the root value has been completely read.
+	bool done() const;
+
+	/** \brief Limit how deeply arrays and objects may nest.
+	 *
+	 * Same as Reader::setStackLimit(): documents nesting more than \c limit
+	 * containers fail with an error, so that input from the network cannot
+	 * build a tree too deep to destroy or write. The default is 1000.
+	 */
+	void setStackLimit(unsigned int limit);
+
+	unsigned int stackLimit() const;
+
+	/// Errors in the format of Reader::getFormattedErrorMessages().
+	std::string getFormattedErrorMessages() const;
+
+	std::vector<std::string> getStructuredErrors() const;
+
+	/// \c true if no error occurred so far.
+	bool good() const;
+
+private:
+	typedef Reader::TokenType TokenType;
+
+	enum Lexer {
+		lexNone, lexString, lexNumber, lexLiteral, lexDone
+	};
+
+	enum NumberPart {
+		numberInteger, numberFraction, numberExponentSign, numberExponent
+	};
+
+	enum Expect {
+		expectRoot,
+		expectValue,
+		expectFirstElement,
+		expectElementSeparator,
+		expectName,
+		expectNameSeparator,
+		expectMemberSeparator
+	};
+
+	/// An open container and whether its last member name was empty.
+	struct Frame {
+		bool object_;
+		bool emptyName_;
+	};
+
+	PushReader(const PushReader&);
+	PushReader& operator=(const PushReader&);
+
+	void startToken(char c);
+	bool continueNumber(char c);
+	bool readToken(TokenType type);
+	bool readRoot(TokenType type);
+	bool readValue(TokenType type);
+	bool openContainer(bool object);
+	bool readName(TokenType type);
+	bool endValue();
+	bool endContainer();
+	bool emitNumber();
+	bool emitString();
+	bool decodeString(std::string& decoded);
+	bool accept(bool accepted);
+	bool decodeError();
+	bool addError(const std::string& message);
+	bool addError(const std::string& message, int line, int column);
+
+	Handler* handler_;
+	ValueBuilder* builder_;
+	/// Decodes the buffered tokens; also holds the stack limit.
+	Reader decoder_;
+	std::vector<Frame> frames_;
+	std::string token_;
+	std::string decoded_;
+	std::string name_;
+	std::string error_;
+	Expect expect_;
+	Lexer lexer_;
+	NumberPart numberPart_;
+	const char* literal_;
+	TokenType literalType_;
+	bool escaped_;
+	bool failed_;
+	bool afterCarriageReturn_;
+	size_t offset_;
+	size_t lineStart_;
+	int line_;
+	int tokenLine_;
+	int tokenColumn_;
+	int errorLine_;
+	int errorColumn_;
+};
+
+} // namespace Json
+
+#endif /* PUSH_READER_H_INCLUDE_MINI_JSONCPP_ */
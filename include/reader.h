@@ -9,9 +9,62 @@
 #define READER_H_INCLUDE_MINI_JSONCPP_
 
 #include "value.h"
+#include "document.h"
+#include "indexer.h"
+#include "number.h"
+#include "handler.h"
+#include "selection.h"
 
 namespace Json {
 
+/** \brief What a Reader read during its last parse, see Reader::stats().
+ *
+ * Only counted in builds with JSON_READER_STATS defined, see config.h.
+ * Token counts and bytes cover what was tokenized: values skipped by a
+ * Selection or a KeyFilter are not counted, nor are the bytes skipped.
+ */
+class ReaderStats {
+public:
+	ReaderStats();
+
+	void clear();
+
+	/// Add the counts of \c other, the deepest of both depths.
+	void add(const ReaderStats& other);
+
+	/// Tokens read, by type; strings include member names.
+	UInt64 objectBegins_;
+	UInt64 objectEnds_;
+	UInt64 arrayBegins_;
+	UInt64 arrayEnds_;
+	UInt64 strings_;
+	UInt64 numbers_;
+	UInt64 trues_;
+	UInt64 falses_;
+	UInt64 nulls_;
+	UInt64 commas_;
+	UInt64 colons_;
+	UInt64 errors_;
+
+	/// Bytes of the tokens, by class, and of the whitespace between them.
+	UInt64 stringBytes_;
+	UInt64 numberBytes_;
+	UInt64 literalBytes_;
+	UInt64 whitespaceBytes_;
+
+	/// Strings with an escape sequence to decode.
+	UInt64 escapedStrings_;
+	/// Numbers decoded as integers and as doubles, and the doubles that
+	/// needed the slow exact conversion.
+	UInt64 integers_;
+	UInt64 doubles_;
+	UInt64 slowDoubles_;
+	/// Objects and arrays allocated, containers reused by recycling are not.
+	UInt64 containers_;
+	/// Deepest nesting of containers.
+	UInt64 maxDepth_;
+};
+
 /** \brief Unserialize a <a HREF="http://www.json.org">JSON</a> document into a
  *Value.
  *
@@ -45,7 +98,17 @@ public:
 	parse(const std::string& document, Value& root);
 
 	/** \brief Read a Value from a <a HREF="http://www.json.org">JSON</a>
-	 document.
+	 document borrowed from the caller.
+	 *
+	 * Unlike parse(const std::string&, Value&) the document is not copied
+	 * into the reader: it is tokenized in place and the reader keeps
+	 * pointers into it. The buffer need not be NUL terminated.
+	 *
+	 * Lifetime contract: the buffer must stay alive and unmodified until the
+	 * next call to a parse method or until the reader is destroyed. Error
+	 * locations reported by getFormattedErrorMessages() are resolved
+	 * against the borrowed buffer. The tree owns its strings, so it does not
+	 * depend on the buffer.
 	 * \param beginDoc Pointer on the beginning of the UTF-8 encoded string of the
 	 document to read.
 	 * \param endDoc Pointer on the end of the UTF-8 encoded string of the
@@ -64,6 +127,134 @@ public:
 	 */
 	bool parse(const char* beginDoc, const char* endDoc, Value& root);
 
+	/** \brief Read a Value from the file at \c path.
+	 *
+	 * Regular files are mapped into memory and tokenized in place, so the
+	 * document is neither copied into a std::string nor into the reader.
+	 * Other files, pipes for instance, are read into the reader. The mapping
+	 * is released before returning: if the parse fails, the document is
+	 * copied for getFormattedErrorMessages() to locate the errors.
+	 * \return \c false, with an error message, if the file cannot be read
+	 * or the document is not valid.
+	 */
+	bool parseFile(const std::string& path, Value& root);
+
+	/** \brief Read a document into the arena of \c root.
+	 *
+	 * Same as parse(const std::string&, Value&), but every node of the tree
+	 * is allocated from the Arena of \c root, see Document. The previous
+	 * content of \c root is freed first.
+	 */
+	bool parse(const std::string& document, Document& root);
+
+	/// Same as parse(const std::string&, Document&) on a borrowed document.
+	bool parse(const char* beginDoc, const char* endDoc, Document& root);
+
+	/** \brief Read only the parts of a document \c selection asks for.
+	 *
+	 * Same as parse(const std::string&, Value&), but \c root only holds the
+	 * selected values and the objects and arrays leading to them; elements
+	 * keep their index, skipped elements before a selected one are null.
+	 * Everything else is skipped by bracket and quote matching, without
+	 * decoding its strings and numbers, so errors inside skipped values are
+	 * not reported.
+	 */
+	bool parse(const std::string& document, const Selection& selection,
+			Value& root);
+
+	/// Same as parse(const std::string&, const Selection&, Value&) on a borrowed document.
+	bool parse(const char* beginDoc, const char* endDoc,
+			const Selection& selection, Value& root);
+
+	/** \brief Parse a document as a stream of events instead of a Value.
+	 *
+	 * Same grammar, errors and root requirements as parse(const std::string&,
+	 * Value&), but no Value tree is built: every value is reported to
+	 * \c handler as it is read. The parse stops at the first error, or as
+	 * soon as a handler method returns \c false.
+	 * \return \c true if the whole document was successfully parsed.
+	 */
+	bool parse(const std::string& document, Handler& handler);
+
+	/// Same as parse(const std::string&, Handler&) on a borrowed document.
+	bool parse(const char* beginDoc, const char* endDoc, Handler& handler);
+
+	/** \brief Same as parse(const char*, const char*, Value&), reading the
+	 * elements of a top-level array on several threads.
+	 *
+	 * A structural scan of the document finds the commas separating the
+	 * elements of the root array; runs of elements are then parsed by
+	 * \c threads threads, each with its own Reader, directly into the slots
+	 * of the root array. The tree is exactly the one the serial parse builds.
+	 *
+	 * Documents whose root is not an array, and any document the threads
+	 * fail to parse, are read again serially so that the result and the
+	 * errors are those of the serial parse. As with parse(const char*,
+	 * const char*, Value&), the document is not copied.
+	 * \param threads Number of threads, the calling thread included; 0 uses
+	 *                one per online CPU.
+	 */
+	bool parseParallel(const char* beginDoc, const char* endDoc, Value& root,
+			int threads = 0);
+
+	/** \brief Parse into the tree already in the root instead of a new one.
+	 *
+	 * By default parse() replaces the content of \c root. With recycling
+	 * the objects, arrays and strings \c root already holds are overwritten
+	 * in place wherever the new document has a value of the same type, and
+	 * only what the new document lacks is freed: parsing documents of the
+	 * same shape into the same Value then allocates next to nothing. A
+	 * successful parse gives the same tree either way; after a failed one
+	 * the part of \c root not yet read still holds the previous document.
+	 *
+	 * The reader always keeps its own buffers from one parse to the next.
+	 */
+	void setRecycling(bool recycling);
+
+	/** \brief Intern the member names of the documents read in \c table.
+	 *
+	 * Objects then refer to the names of the table instead of holding a
+	 * copy each, see KeyTable, which must outlive the Values parsed. The
+	 * table may be shared with other readers. NULL, the default, stops
+	 * interning.
+	 */
+	void setKeyTable(KeyTable* table);
+
+	/** \brief Skip the object members \c filter rejects, at any depth.
+	 *
+	 * Rejected members are passed over at tokenizer speed without building
+	 * their value, in every kind of parse. The filter must outlive the
+	 * parses; NULL, the default, keeps every member.
+	 */
+	void setKeyFilter(const KeyFilter* filter);
+
+	/** \brief Reject documents that are not well-formed UTF-8.
+	 *
+	 * By default the bytes of strings are taken as they are. In strict
+	 * mode the whole document is validated before it is read, in a pass
+	 * that accepts each 64 byte block of ASCII with one test: overlong
+	 * forms, encoded surrogates, code points above U+10FFFF and truncated
+	 * or stray sequences fail the parse with an error at the first bad byte.
+	 */
+	void setStrictUtf8(bool strict);
+
+	/** \brief Limit how deeply arrays and objects may nest.
+	 *
+	 * Documents nesting more than \c limit containers fail to parse with an
+	 * error. The reader does not recurse, so the limit only bounds the
+	 * memory of its stack of open containers. The default is 1000.
+	 */
+	void setStackLimit(unsigned int limit);
+
+	unsigned int stackLimit() const;
+
+	/** \brief Counts of what the last parse read, for profiling payloads.
+	 *
+	 * Zero unless the library is built with JSON_READER_STATS. A parallel
+	 * parse adds up the counts of its threads.
+	 */
+	const ReaderStats& stats() const;
+
 	/** \brief Returns a user friendly string that list errors in the parsed
 	 * document.
 	 * \return Formatted error message with the list of errors with their location
@@ -83,6 +274,15 @@ public:
 	bool good() const;
 
 private:
+	// Reuses the token decoding for documents read in chunks.
+	friend class PushReader;
+	// Reports record errors located in the whole input.
+	friend class LinesReader;
+	// Navigates the document without building it.
+	friend class LazyDocument;
+	// Reads the tokens straight into bound C++ types.
+	friend class BindReader;
+
 	enum TokenType {
 		tokenEndOfStream = 0,
 		tokenObjectBegin,
@@ -118,14 +318,51 @@ private:
 
 	typedef std::deque<ErrorInfo> Errors;
 
+	/// A container being read, see readValue().
+	class Frame {
+	public:
+		bool object_;
+		/// A member or element was built and must be ended.
+		bool built_;
+		/// The last member name was empty.
+		bool emptyName_;
+		ArrayIndex index_;
+	};
+
+	typedef std::vector<Frame> Frames;
+
+	class ValueSink;
+	class HandlerSink;
+	class SelectSink;
+	class ArraySlices;
+
+	void start(Location beginDoc, Location endDoc);
 	bool readToken(Token& token);
+	void countToken(const Token& token, Location spaces);
 	void skipSpaces();
+	Location seekIndex(Location location);
+	bool nextIndexEntry();
+	bool refillIndex();
 	bool match(Location pattern, int patternLength);
 	bool readString();
 	void readNumber();
-	bool readValue();
-	bool readObject();
-	bool readArray();
+	template<typename Sink> bool readValue(Sink& sink);
+	bool recoverNested();
+	bool checkUtf8();
+	void reserveMembers(Value& object);
+	void countMembers(const Value& object);
+	void startRecycled(ValueType type);
+	Value& recycledMember(Value& object, const Key& key);
+	void endRecycled();
+	void seek(Location location);
+	bool skipValue();
+	bool skipUnselected();
+	bool decodeValue(Location location, Value& decoded);
+	bool splitArray(ArraySlices& slices);
+	bool readElements(ArraySlices& slices, size_t first, size_t last);
+	static void* readSlices(void* slices);
+	bool fileError(const std::string& message);
+	void rebase(Location from, Location to);
 	bool decodeNumber(Token& token);
 	bool decodeNumber(Token& token, Value& decoded);
 	bool decodeString(Token& token);
@@ -147,7 +384,7 @@ private:
 	getLocationLineAndColumn(Location location, int& line, int& column) const;
 	std::string getLocationLineAndColumn(Location location) const;
 
-	typedef std::stack<Value*> Nodes;
+	typedef std::vector<Value*> Nodes;
 	Nodes nodes_;
 	Errors errors_;
 	std::string document_;
@@ -156,6 +393,30 @@ private:
 	Location current_;
 	Location lastValueEnd_;
 	Value* lastValue_;
+	StructuralIndex index_;
+	const StructuralIndex::Offset* indexCurrent_;
+	const StructuralIndex::Offset* indexEnd_;
+	bool indexed_;
+	/// Where the containers and strings of the tree go, NULL for the heap.
+	Arena* arena_;
+	/// The containers being read and how deep they may nest.
+	Frames frames_;
+	unsigned int stackLimit_;
+	/// Scratch space for names and strings, kept across parses.
+	std::string name_;
+	std::string decoded_;
+	/// See setRecycling(): for each open container the number of members
+	/// or elements read again, or with JSON_MAP_OBJECTS the first of its
+	/// members in touched_.
+	bool recycling_;
+	std::vector<size_t> recycled_;
+	std::vector<Value*> touched_;
+	/// Size of the last object read at each depth, to size the next one.
+	std::vector<size_t> memberCounts_;
+	KeyTable* keyTable_;
+	const KeyFilter* keyFilter_;
+	bool strictUtf8_;
+	ReaderStats stats_;
 	int debug;
 };
 // Reader
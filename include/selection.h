@@ -0,0 +1,111 @@
+/*
+ * selection.h
+ *
+ *  Created on: 2026-10-17
+ */
+
+#ifndef SELECTION_H_INCLUDE_MINI_JSONCPP_
+#define SELECTION_H_INCLUDE_MINI_JSONCPP_
+
+#include "config.h"
+
+namespace Json {
+
+/** \brief The parts of a document to build, as a list of paths.
+ *
+ * Paths are JSON Pointers (RFC 6901): "/user/id" is the member "id" of the
+ * member "user" of the root, "~1" and "~0" stand for '/' and '~' in a name,
+ * and a number also names an array element. A segment "*" matches every
+ * member or element, so the segments "events", "*" and "ts" select the "ts"
+ * of every element of "events". The empty path selects the whole document.
+ *
+ * Pass a Selection to Reader::parse() to build only the selected values and
+ * the containers leading to them. Build it once and reuse it: the paths are
+ * compiled into a tree walked as the document is read.
+ */
+class Selection {
+public:
+	Selection();
+	explicit Selection(const std::vector<std::string>& paths);
+
+	/// Add a path, \c false if it is not a JSON Pointer.
+	bool add(const std::string& path);
+
+	void clear();
+
+	bool empty() const;
+
+private:
+	friend class Reader;
+
+	typedef std::map<std::string, size_t> Children;
+
+	/// A segment of the paths; nodes are referred to by their index.
+	class Node {
+	public:
+		Node() :
+				any_(none), whole_(false) {
+		}
+
+		Children children_;
+		/// The node "*" leads to, none if no path has one here.
+		size_t any_;
+		/// A path ends here: everything below is selected.
+		bool whole_;
+	};
+
+	static const size_t none = 0;
+
+	size_t addNode();
+	size_t copyNode(size_t node);
+	void insert(size_t node, const std::vector<std::string>& segments,
+			size_t first);
+
+	/// The node \c name leads to from \c node, none if it is not selected.
+	size_t child(size_t node, const std::string& name) const;
+	size_t child(size_t node, ArrayIndex index) const;
+	bool whole(size_t node) const;
+
+	/// The root is node 0, which also serves as none for children.
+	std::vector<Node> nodes_;
+};
+
+/** \brief Members to drop from documents by name, at any depth.
+ *
+ * Where a Selection names paths from the root, a filter is consulted for
+ * every member of every object. Members it rejects are skipped with the
+ * structural index before their value is read, so nothing of them is
+ * allocated.
+ *
+ * By default a member is dropped if its name was denied, or if any name
+ * was allowed and its name was not: with "user" and "id" allowed,
+ * {"user": {"id": 1, "name": "x"}, "ip": "::1"} is read as
+ * {"user": {"id": 1}}. Override keep() to decide with a predicate
+ * instead. Pass the filter to Reader::setKeyFilter().
+ */
+class KeyFilter {
+public:
+	KeyFilter();
+	virtual ~KeyFilter();
+
+	/// Drop the members named \c name.
+	void deny(const std::string& name);
+
+	/// Keep only the members with an allowed name.
+	void allow(const std::string& name);
+
+	void clear();
+
+	/// \c true to build the member \c name, \c false to skip it.
+	virtual bool keep(const std::string& name) const;
+
+private:
+	typedef std::set<std::string> Names;
+
+	Names denied_;
+	Names allowed_;
+};
+
+} // namespace Json
+
+#endif /* SELECTION_H_INCLUDE_MINI_JSONCPP_ */
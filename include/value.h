@@ -10,6 +10,11 @@
 
 #include "config.h"
 #include "tools.h"
+#include "arena.h"
+#include "key.h"
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
 
 namespace Json {
 
@@ -52,6 +57,8 @@ enum ValueType {
  * The get() methods can be used to obtain default value in the case the  required element does not exist.
  *
  * It is possible to iterate over the list of a #objectValue values using the getMemberNames() method.
+ * Members are listed in the order they were added, see ObjectTable. As with std::map, a reference to a
+ * member stays valid until that member is removed.
  *
  * note #Value string-length fit in size_t, but keys must be < 2^30.
  * (The reason is an implementation detail.)
@@ -69,9 +76,16 @@ public:
 	typedef Json::LargestInt LargestInt;
 	typedef Json::LargestUInt LargestUInt;
 	typedef Json::ArrayIndex ArrayIndex;
-	typedef std::map<string, Value> ObjectValues;
-	typedef std::vector<Value> ArrayValues;
-	typedef std::string StringValues;
+	/// Containers, and strings too long to be stored in the Value itself,
+	/// allocate from the Arena of a Document, or from the heap.
+	typedef std::basic_string<char, std::char_traits<char>, ArenaAllocator<char> > StringValues;
+#ifdef JSON_MAP_OBJECTS
+	typedef std::map<Key, Value, std::less<Key>,
+			ArenaAllocator<std::pair<const Key, Value> > > ObjectValues;
+#else
+	typedef ObjectTable ObjectValues;
+#endif
+	typedef std::vector<Value, ArenaAllocator<Value> > ArrayValues;
 
 public:
 	///< We regret this reference to a global instance; prefer the simpler Value().
@@ -125,7 +139,19 @@ public:
 	Value(const std::string& value);
 	Value(bool value);
 
+	/** \brief Create an empty string, array or object allocated from
+	 * \c arena, or from the heap if it is NULL.
+	 *
+	 * The payload belongs to the arena: it is released with it and never by
+	 * the Value. Used by Reader to build a Document.
+	 */
+	Value(ValueType type, Arena* arena);
+	/// A string of the bytes [begin, end), allocated like Value(ValueType, Arena*).
+	Value(const char* begin, const char* end, Arena* arena);
+
 	Value(const Value& other);
+	/// Take the content of \c other, which is left null.
+	Value(Value&& other) noexcept;
 
 	void destructor();
 	~Value();
@@ -134,6 +160,9 @@ public:
 	 *  Deep copy, then swap(other).
 	 */
 	Value& operator=(const Value& other);
+	/// Take the content of \c other, which is left null; \c other may be a
+	/// member or element of this value.
+	Value& operator=(Value&& other) noexcept;
 
 	/*
 	 * Swap everything.
@@ -218,22 +247,62 @@ public:
 	const Value& operator[](int index) const;
 
 	/// Most general and efficient version of isMember()const, get()const,
-	/// and operator[]const
+	/// and operator[]const: the name [begin, end) is looked up in place,
+	/// without a temporary string, and may hold any byte.
 	/// \note As stated elsewhere, behavior is undefined if (end-key) >= 2^30
+	Value * find(const char* begin, const char* end);
+	const Value * find(const char* begin, const char* end) const;
 	Value * find(const std::string& key);
 	const Value * find(const std::string& key) const;
 	Value * find(const char* key);
 	const Value * find(const char* key) const;
 
+	/** \brief The member named [begin, end), added as null if it does not
+	 * exist, in a single lookup.
+	 *
+	 * Same as operator[](), setting \c *inserted, if given, to whether the
+	 * member was added.
+	 */
+	Value& findOrInsert(const char* begin, const char* end,
+			bool* inserted = NULL);
+
+	/// The member named [begin, end), or \c defaultValue if there is none.
+	Value get(const char* begin, const char* end,
+			const Value& defaultValue) const;
+	Value get(const std::string& key, const Value& defaultValue) const;
+	Value get(const char* key, const Value& defaultValue) const;
+
+#if __cplusplus >= 201703L
+	Value * find(std::string_view key) {
+		return find(key.data(), key.data() + key.size());
+	}
+	const Value * find(std::string_view key) const {
+		return find(key.data(), key.data() + key.size());
+	}
+	Value& findOrInsert(std::string_view key, bool* inserted = NULL) {
+		return findOrInsert(key.data(), key.data() + key.size(), inserted);
+	}
+	Value get(std::string_view key, const Value& defaultValue) const {
+		return get(key.data(), key.data() + key.size(), defaultValue);
+	}
+	bool isMember(std::string_view key) const {
+		return isMember(key.data(), key.data() + key.size());
+	}
+#endif
+
 	/// \brief Append value to array at the end.
 	/// Equivalent to jsonvalue[jsonvalue.size()] = value;
-	void append(const Value& value);
+	/// \return the new element, to be filled in place.
+	Value& append(const Value& value);
+	/// Same as append(const Value&), moving \c value instead of copying it.
+	Value& append(Value&& value);
 
 	/// Access an object value by name, create a null member if it does not exist.
 	/// \note Because of our implementation, keys are limited to 2^30 -1 chars.
 	///  Exceeding that will cause an exception.
 	Value& operator[](const string& key);
 	Value& operator[](const char* key);
+	/// Access an object value by name, returns null if there is no such member.
 	const Value& operator[](const string& key) const;
 	const Value& operator[](const char* key) const;
 
@@ -250,6 +319,8 @@ public:
 
 	/// Return true if the object has a member named key.
 	bool isMember(const std::string& key) const;
+	bool isMember(const char* key) const;
+	bool isMember(const char* begin, const char* end) const;
 
 	/// \brief Return a list of the member names.
 	/// If null, return an empty list.
@@ -257,9 +328,33 @@ public:
 
 	std::string toStyledString() const;
 private:
-	void initBasic(ValueType type);
+	// Overwrites the payloads of a tree in place, see Reader::setRecycling().
+	friend class Reader;
+
+	void initBasic(ValueType type, Arena* arena = NULL);
+	bool inArena() const;
+	Value& member(const Key& key, bool* inserted = NULL);
+
+	/// Strings of up to shortLength bytes are stored in the Value itself.
+	static const size_t shortLength = 14;
+	/// shortLength_ of a string allocated in value_.string_.
+	static const unsigned char longString = 0xFF;
+
+	bool isShortString() const {
+		return shortLength_ != longString;
+	}
+	char* shortString() {
+		return reinterpret_cast<char*>(&value_);
+	}
+	const char* shortString() const {
+		return reinterpret_cast<const char*>(&value_);
+	}
+	const char* stringData() const;
+	size_t stringLength() const;
+	/// Replace the bytes of a string, long ones allocated from \c arena.
+	void assignString(const char* data, size_t length, Arena* arena = NULL);
+	void releaseString();
 
-	StringValues*getStringVaule();
 	ObjectValues* getObjectVaule();
 	ArrayValues* getArrayVaule();
 
@@ -276,8 +371,12 @@ private:
 		ObjectValues* map_;
 		ArrayValues* array_;
 	} value_;
-	ValueType type_;
-
+	/// Continues value_ for short strings: inline bytes are not terminated.
+	char shortTail_[shortLength - sizeof(ValueHolder)];
+	/// Length of a short string, or longString; 0 for other types.
+	unsigned char shortLength_;
+	/// The ValueType, in a byte to keep a Value in 16 bytes.
+	unsigned char type_;
 };
 
 }
@@ -0,0 +1,82 @@
+/*
+ * arena.cpp
+ *
+ *  Created on: 2026-10-17
+ */
+
+#include "arena.h"
+
+namespace Json {
+
+static const size_t firstBlockSize = 64 * 1024;
+static const size_t maxBlockSize = 4 * 1024 * 1024;
+
+Arena::Arena() :
+		blocks_(NULL), current_(NULL), end_(NULL), used_(0) {
+}
+
+Arena::~Arena() {
+	while (blocks_ != NULL) {
+		Block* next = blocks_->next_;
+		free(blocks_);
+		blocks_ = next;
+	}
+}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+	char* start = (char*) ((size_t(current_) + alignment - 1)
+			& ~(alignment - 1));
+	if (current_ == NULL || start + size > end_) {
+		return allocateBlock(size, alignment);
+	}
+	current_ = start + size;
+	used_ += size;
+	return start;
+}
+
+void* Arena::allocateBlock(size_t size, size_t alignment) {
+	// Blocks double up to maxBlockSize; larger requests get a block of
+	// their own.
+	size_t blockSize = blocks_ == NULL ? firstBlockSize : blocks_->size_ * 2;
+	if (blockSize > maxBlockSize) {
+		blockSize = maxBlockSize;
+	}
+	size_t header = (sizeof(Block) + alignment - 1) & ~(alignment - 1);
+	if (blockSize < header + size) {
+		blockSize = header + size;
+	}
+
+	Block* block = static_cast<Block*>(malloc(blockSize));
+	if (block == NULL) {
+		throw std::bad_alloc();
+	}
+	block->next_ = blocks_;
+	block->size_ = blockSize;
+	blocks_ = block;
+
+	char* start = (char*) block + header;
+	current_ = start + size;
+	end_ = (char*) block + blockSize;
+	used_ += size;
+	return start;
+}
+
+void Arena::clear() {
+	if (blocks_ == NULL) {
+		return;
+	}
+	while (blocks_->next_ != NULL) {
+		Block* next = blocks_->next_;
+		blocks_->next_ = next->next_;
+		free(next);
+	}
+	current_ = (char*) blocks_ + sizeof(Block);
+	end_ = (char*) blocks_ + blocks_->size_;
+	used_ = 0;
+}
+
+size_t Arena::used() const {
+	return used_;
+}
+
+} // namespace Json
@@ -0,0 +1,376 @@
+/*
+ * bind.cpp
+ *
+ *  Created on: 2026-10-17
+ */
+
+#include "bind.h"
+#include "writer.h"
+
+namespace Json {
+
+// Class BindReader
+// //////////////////////////////////////////////////////////////////
+
+BindReader::BindReader() :
+		depth_(0) {
+}
+
+bool BindReader::start(const char* beginDoc, const char* endDoc) {
+	depth_ = 0;
+	reader_.start(beginDoc, endDoc);
+	return reader_.checkUtf8();
+}
+
+/// The result of a parse, its errors moved to a copy of the document if it
+/// failed: the caller's one may be a temporary.
+bool BindReader::finish(bool successful) {
+	if (!successful) {
+		const char* begin = reader_.begin_;
+		reader_.document_.assign(begin, reader_.end_ - begin);
+		reader_.rebase(begin, reader_.document_.data());
+	}
+	return successful;
+}
+
+std::string BindReader::getFormattedErrorMessages() const {
+	return reader_.getFormattedErrorMessages();
+}
+
+std::vector<std::string> BindReader::getStructuredErrors() const {
+	return reader_.getStructuredErrors();
+}
+
+bool BindReader::good() const {
+	return reader_.good();
+}
+
+bool BindReader::addError(const std::string& message, Reader::Token& token) {
+	return reader_.addError(message, token);
+}
+
+bool BindReader::read(bool& value) {
+	Reader::Token token;
+	reader_.readToken(token);
+	if (token.type_ != Reader::tokenTrue && token.type_ != Reader::tokenFalse) {
+		return addError("Expected a boolean.", token);
+	}
+	value = token.type_ == Reader::tokenTrue;
+	return true;
+}
+
+/// Read a number token and split it into \c number.
+bool BindReader::readNumber(Reader::Token& token, NumberParts& number) {
+	reader_.readToken(token);
+	if (token.type_ != Reader::tokenNumber) {
+		return addError("Expected a number.", token);
+	}
+	scanNumber(token.start_, token.end_, number);
+	return true;
+}
+
+bool BindReader::read(Int64& value, Int64 minimum, Int64 maximum) {
+	Reader::Token token;
+	NumberParts number;
+	if (!readNumber(token, number)) {
+		return false;
+	}
+	UInt64 magnitude = number.integer_;
+	bool fits = number.integral_
+			&& (number.negative_ ?
+					magnitude <= UInt64(0) - UInt64(minimum) :
+					magnitude <= UInt64(maximum));
+	if (!fits) {
+		return addError(
+				"'" + std::string(token.start_, token.end_)
+						+ "' is not an integer in the range of the field.",
+				token);
+	}
+	value = number.negative_ ? Int64(UInt64(0) - magnitude) : Int64(magnitude);
+	return true;
+}
+
+bool BindReader::read(UInt64& value, UInt64 maximum) {
+	Reader::Token token;
+	NumberParts number;
+	if (!readNumber(token, number)) {
+		return false;
+	}
+	if (!number.integral_ || number.integer_ > maximum
+			|| (number.negative_ && number.integer_ != 0)) {
+		return addError(
+				"'" + std::string(token.start_, token.end_)
+						+ "' is not an integer in the range of the field.",
+				token);
+	}
+	value = number.integer_;
+	return true;
+}
+
+bool BindReader::read(double& value) {
+	Reader::Token token;
+	NumberParts number;
+	if (!readNumber(token, number)) {
+		return false;
+	}
+	if (!convertDouble(number, value)) {
+		return addError(
+				"'" + std::string(token.start_, token.end_)
+						+ "' is not a number.", token);
+	}
+	return true;
+}
+
+bool BindReader::read(std::string& value) {
+	Reader::Token token;
+	reader_.readToken(token);
+	if (token.type_ != Reader::tokenString) {
+		return addError("Expected a string.", token);
+	}
+	value.clear();
+	return reader_.decodeString(token, value);
+}
+
+bool BindReader::read(Value& value) {
+	reader_.skipSpaces();
+	return reader_.decodeValue(reader_.current_, value);
+}
+
+bool BindReader::readNull() {
+	reader_.skipSpaces();
+	if (reader_.current_ == reader_.end_ || *reader_.current_ != 'n') {
+		return false;
+	}
+	Reader::Token token;
+	reader_.readToken(token);
+	if (token.type_ != Reader::tokenNull) {
+		// Let the caller report the bad token.
+		reader_.seek(token.start_);
+		return false;
+	}
+	return true;
+}
+
+bool BindReader::skipValue() {
+	Reader::Token token;
+	token.start_ = reader_.current_;
+	if (!reader_.skipValue()) {
+		return addError("Syntax error: value, object or array expected.",
+				token);
+	}
+	return true;
+}
+
+bool BindReader::startContainer(Reader::TokenType type, const char* message) {
+	Reader::Token token;
+	reader_.readToken(token);
+	if (token.type_ != type) {
+		return addError(message, token);
+	}
+	if (depth_ >= reader_.stackLimit()) {
+		return addError("Exceeded the nesting limit of the reader.", token);
+	}
+	++depth_;
+	return true;
+}
+
+bool BindReader::startObject() {
+	return startContainer(Reader::tokenObjectBegin, "Expected an object.");
+}
+
+bool BindReader::nextMember(ArrayIndex& count) {
+	Reader::Token token;
+	reader_.readToken(token);
+	if (token.type_ == Reader::tokenObjectEnd) {
+		--depth_;
+		return false;
+	}
+	if (count != 0) {
+		if (token.type_ != Reader::tokenArraySeparator) {
+			return addError("Missing ',' or '}' in object declaration", token);
+		}
+		reader_.readToken(token);
+	}
+
+	name_.clear();
+	if (token.type_ == Reader::tokenString) {
+		if (!reader_.decodeString(token, name_)) {
+			return false;
+		}
+	} else if (token.type_ == Reader::tokenNumber) {
+		Value numberName;
+		if (!reader_.decodeNumber(token, numberName)) {
+			return false;
+		}
+		name_ = numberName.asString();
+	} else {
+		return addError("Missing '}' or object member name", token);
+	}
+
+	Reader::Token colon;
+	if (!reader_.readToken(colon) || colon.type_ != Reader::tokenMemberSeparator) {
+		return addError("Missing ':' after object member name", colon);
+	}
+	++count;
+	return true;
+}
+
+const std::string& BindReader::memberName() const {
+	return name_;
+}
+
+bool BindReader::startArray() {
+	return startContainer(Reader::tokenArrayBegin, "Expected an array.");
+}
+
+bool BindReader::nextElement(ArrayIndex& count) {
+	if (count == 0) {
+		reader_.skipSpaces();
+		if (reader_.current_ == reader_.end_ || *reader_.current_ != ']') {
+			++count;
+			return true;
+		}
+	}
+	Reader::Token token;
+	reader_.readToken(token);
+	if (token.type_ == Reader::tokenArrayEnd) {
+		--depth_;
+		return false;
+	}
+	if (token.type_ != Reader::tokenArraySeparator) {
+		return addError("Missing ',' or ']' in array declaration", token);
+	}
+	++count;
+	return true;
+}
+
+// Class BindWriter
+// //////////////////////////////////////////////////////////////////
+
+BindWriter::BindWriter(std::string& document) :
+		document_(document), comma_(false) {
+}
+
+void BindWriter::separate() {
+	if (comma_) {
+		document_ += ',';
+	}
+	comma_ = true;
+}
+
+void BindWriter::null() {
+	separate();
+	document_ += "null";
+}
+
+void BindWriter::value(bool value) {
+	separate();
+	document_ += value ? "true" : "false";
+}
+
+void BindWriter::value(Int64 value) {
+	separate();
+	document_ += valueToString(LargestInt(value));
+}
+
+void BindWriter::value(UInt64 value) {
+	separate();
+	document_ += valueToString(LargestUInt(value));
+}
+
+void BindWriter::value(double value) {
+	separate();
+	document_ += valueToString(value);
+}
+
+/// Append [value, value + length) quoted, escaped as valueToQuotedString().
+static void appendQuoted(std::string& document, const char* value,
+		size_t length) {
+	static const char hex[] = "0123456789ABCDEF";
+	document += '"';
+	const char* run = value;
+	const char* end = value + length;
+	for (const char* c = value; c != end; ++c) {
+		unsigned char byte = (unsigned char) *c;
+		if (byte >= 0x20 && byte != '"' && byte != '\\') {
+			continue;
+		}
+		document.append(run, c);
+		run = c + 1;
+		switch (byte) {
+		case '"':
+			document += "\\\"";
+			break;
+		case '\\':
+			document += "\\\\";
+			break;
+		case '\b':
+			document += "\\b";
+			break;
+		case '\f':
+			document += "\\f";
+			break;
+		case '\n':
+			document += "\\n";
+			break;
+		case '\r':
+			document += "\\r";
+			break;
+		case '\t':
+			document += "\\t";
+			break;
+		default:
+			document += "\\u00";
+			document += hex[byte >> 4];
+			document += hex[byte & 0xF];
+			break;
+		}
+	}
+	document.append(run, end);
+	document += '"';
+}
+
+void BindWriter::value(const char* value, size_t length) {
+	separate();
+	appendQuoted(document_, value, length);
+}
+
+void BindWriter::value(const Value& value) {
+	separate();
+	FastWriter writer;
+	writer.omitEndingLineFeed();
+	document_ += writer.write(value);
+}
+
+void BindWriter::startObject() {
+	separate();
+	document_ += '{';
+	comma_ = false;
+}
+
+void BindWriter::key(const char* name, size_t length) {
+	if (comma_) {
+		document_ += ',';
+	}
+	appendQuoted(document_, name, length);
+	document_ += ':';
+	comma_ = false;
+}
+
+void BindWriter::endObject() {
+	document_ += '}';
+	comma_ = true;
+}
+
+void BindWriter::startArray() {
+	separate();
+	document_ += '[';
+	comma_ = false;
+}
+
+void BindWriter::endArray() {
+	document_ += ']';
+	comma_ = true;
+}
+
+} // namespace Json
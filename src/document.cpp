@@ -0,0 +1,32 @@
+/*
+ * document.cpp
+ *
+ *  Created on: 2026-10-17
+ */
+
+#include "document.h"
+
+namespace Json {
+
+Document::Document() {
+}
+
+const Value& Document::root() const {
+	return root_;
+}
+
+void Document::clear() {
+	// The payloads of the tree belong to the arena: dropping the root does
+	// not visit them, but must happen before they are released.
+	{
+		Value null;
+		root_.swap(null);
+	}
+	arena_.clear();
+}
+
+size_t Document::memoryUsed() const {
+	return arena_.used();
+}
+
+} // namespace Json
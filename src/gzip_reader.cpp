@@ -0,0 +1,165 @@
+/*
+ * gzip_reader.cpp
+ *
+ *  Created on: 2026-10-17
+ */
+
+#include "gzip_reader.h"
+#include <errno.h>
+#include <zlib.h>
+
+namespace Json {
+
+/// Decompressed bytes handed to the parser at a time.
+static const size_t chunkBytes = 64 * 1024;
+
+/// Window bits accepting either a gzip or a zlib header.
+static const int detectHeader = 15 + 32;
+
+// Class GzipReader
+// //////////////////////////////////////////////////////////////////
+
+GzipReader::GzipReader(Handler& handler) :
+		reader_(handler), stream_(new z_stream_s()), output_(chunkBytes) {
+	start();
+}
+
+GzipReader::GzipReader(Value& root) :
+		reader_(root), stream_(new z_stream_s()), output_(chunkBytes) {
+	start();
+}
+
+GzipReader::~GzipReader() {
+	inflateEnd(stream_);
+	delete stream_;
+}
+
+void GzipReader::start() {
+	if (inflateInit2(stream_, detectHeader) != Z_OK) {
+		throw std::bad_alloc();
+	}
+	errorOffset_ = 0;
+	ended_ = false;
+}
+
+void GzipReader::reset() {
+	inflateReset(stream_);
+	stream_->total_in = 0;
+	reader_.reset();
+	error_.clear();
+	errorOffset_ = 0;
+	ended_ = false;
+}
+
+void GzipReader::setStackLimit(unsigned int limit) {
+	reader_.setStackLimit(limit);
+}
+
+unsigned int GzipReader::stackLimit() const {
+	return reader_.stackLimit();
+}
+
+bool GzipReader::feed(const std::string& data) {
+	return feed(data.data(), data.length());
+}
+
+bool GzipReader::feed(const char* data, size_t length) {
+	// avail_in is 32 bits wide: feed long inputs in pieces.
+	while (length > 0 && good()) {
+		uInt size = length < chunkBytes ? uInt(length) : uInt(chunkBytes);
+		stream_->next_in = (Bytef*) data;
+		stream_->avail_in = size;
+		data += size;
+		length -= size;
+
+		do {
+			if (ended_) {
+				if (stream_->avail_in == 0) {
+					break;
+				}
+				// Another gzip member follows the one that ended.
+				uLong totalIn = stream_->total_in;
+				inflateReset(stream_);
+				stream_->total_in = totalIn;
+				ended_ = false;
+			}
+			stream_->next_out = (Bytef*) &output_[0];
+			stream_->avail_out = uInt(output_.size());
+			int status = inflate(stream_, Z_NO_FLUSH);
+			size_t produced = output_.size() - stream_->avail_out;
+			if (produced > 0 && !reader_.feed(&output_[0], produced)) {
+				return false;
+			}
+			if (status == Z_STREAM_END) {
+				ended_ = true;
+			} else if (status != Z_OK && status != Z_BUF_ERROR) {
+				return addError(
+						std::string("Invalid compressed data: ")
+								+ (stream_->msg != NULL ?
+										stream_->msg : zError(status)));
+			}
+		} while (stream_->avail_in > 0 || stream_->avail_out == 0);
+	}
+	return good();
+}
+
+bool GzipReader::finish() {
+	if (!good()) {
+		return false;
+	}
+	if (!ended_) {
+		return addError("Unexpected end of the compressed data.");
+	}
+	return reader_.finish();
+}
+
+bool GzipReader::parseFile(const std::string& path) {
+	FILE* file = fopen(path.c_str(), "rb");
+	if (file == NULL) {
+		return addError("Cannot open " + path + ": " + strerror(errno));
+	}
+	std::vector<char> input(chunkBytes);
+	size_t count;
+	while ((count = fread(&input[0], 1, input.size(), file)) > 0) {
+		if (!feed(&input[0], count)) {
+			break;
+		}
+	}
+	bool failed = ferror(file) != 0;
+	fclose(file);
+	if (failed && good()) {
+		return addError("Cannot read " + path);
+	}
+	return finish();
+}
+
+bool GzipReader::addError(const std::string& message) {
+	error_ = message;
+	errorOffset_ = stream_->total_in;
+	return false;
+}
+
+std::string GzipReader::getFormattedErrorMessages() const {
+	if (error_.empty()) {
+		return reader_.getFormattedErrorMessages();
+	}
+	char buffer[32 + 20 + 1];
+	snprintf(buffer, sizeof(buffer), "Compressed byte %lu",
+			(unsigned long) errorOffset_);
+	return std::string("* ") + buffer + "\n  " + error_ + "\n";
+}
+
+std::vector<std::string> GzipReader::getStructuredErrors() const {
+	if (error_.empty()) {
+		return reader_.getStructuredErrors();
+	}
+	std::vector<std::string> allErrors;
+	allErrors.push_back(error_);
+	return allErrors;
+}
+
+bool GzipReader::good() const {
+	return error_.empty() && reader_.good();
+}
+
+} // namespace Json
@@ -0,0 +1,142 @@
+/*
+ * handler.cpp
+ *
+ *  Created on: 2026-10-17
+ */
+
+#include "handler.h"
+#include "value.h"
+
+namespace Json {
+
+// Class Handler
+// //////////////////////////////////////////////////////////////////
+
+Handler::~Handler() {
+}
+
+bool Handler::null() {
+	return true;
+}
+
+bool Handler::boolean(bool value) {
+	return true;
+}
+
+bool Handler::int64(Int64 value) {
+	return true;
+}
+
+bool Handler::uint64(UInt64 value) {
+	return true;
+}
+
+bool Handler::real(double value) {
+	return true;
+}
+
+bool Handler::string(const char* value, size_t length) {
+	return true;
+}
+
+bool Handler::startObject() {
+	return true;
+}
+
+bool Handler::key(const char* name, size_t length) {
+	return true;
+}
+
+bool Handler::endObject() {
+	return true;
+}
+
+bool Handler::startArray() {
+	return true;
+}
+
+bool Handler::endArray() {
+	return true;
+}
+
+// Class ValueBuilder
+// //////////////////////////////////////////////////////////////////
+
+ValueBuilder::ValueBuilder(Value& root) :
+		root_(root) {
+}
+
+void ValueBuilder::reset() {
+	nodes_.clear();
+}
+
+Value& ValueBuilder::next() {
+	if (nodes_.empty()) {
+		return root_;
+	}
+	Value& container = *nodes_.back();
+	if (container.isArray()) {
+		return container.append(Value());
+	}
+	return container[key_];
+}
+
+bool ValueBuilder::set(Value&& value) {
+	next() = std::move(value);
+	return true;
+}
+
+bool ValueBuilder::null() {
+	return set(Value());
+}
+
+bool ValueBuilder::boolean(bool value) {
+	return set(Value(value));
+}
+
+bool ValueBuilder::int64(Int64 value) {
+	return set(Value(value));
+}
+
+bool ValueBuilder::uint64(UInt64 value) {
+	return set(Value(value));
+}
+
+bool ValueBuilder::real(double value) {
+	return set(Value(value));
+}
+
+bool ValueBuilder::string(const char* value, size_t length) {
+	return set(Value(value, value + length, NULL));
+}
+
+bool ValueBuilder::startObject() {
+	Value& node = next();
+	node = Value(objectValue);
+	nodes_.push_back(&node);
+	return true;
+}
+
+bool ValueBuilder::key(const char* name, size_t length) {
+	key_.assign(name, length);
+	return true;
+}
+
+bool ValueBuilder::endObject() {
+	nodes_.pop_back();
+	return true;
+}
+
+bool ValueBuilder::startArray() {
+	Value& node = next();
+	node = Value(arrayValue);
+	nodes_.push_back(&node);
+	return true;
+}
+
+bool ValueBuilder::endArray() {
+	nodes_.pop_back();
+	return true;
+}
+
+} // namespace Json
@@ -0,0 +1,491 @@
+/*
+ * indexer.cpp
+ *
+ *  Created on: 2026-10-17
+ */
+
+#include "indexer.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define JSON_INDEXER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Json {
+
+typedef unsigned long long Bits;
+
+/// One bit per byte of a 64 byte block, lowest bit is the first byte.
+struct BlockMasks {
+	Bits quote;
+	Bits backslash;
+	Bits space;
+	Bits op;
+	/// Bytes with the high bit set, the only ones UTF-8 validation looks at.
+	Bits nonAscii;
+};
+
+typedef void (*ClassifyBlock)(const char* block, BlockMasks& masks);
+
+static void classifyScalar(const char* block, BlockMasks& masks) {
+	Bits quote = 0, backslash = 0, space = 0, op = 0, nonAscii = 0;
+	for (int i = 0; i < 64; ++i) {
+		Bits bit = Bits(1) << i;
+		if ((unsigned char) block[i] >= 0x80) {
+			nonAscii |= bit;
+		}
+		switch (block[i]) {
+		case '"':
+			quote |= bit;
+			break;
+		case '\\':
+			backslash |= bit;
+			break;
+		case ' ':
+		case '\t':
+		case '\r':
+		case '\n':
+			space |= bit;
+			break;
+		case '{':
+		case '}':
+		case '[':
+		case ']':
+		case ':':
+		case ',':
+			op |= bit;
+			break;
+		default:
+			break;
+		}
+	}
+	masks.quote = quote;
+	masks.backslash = backslash;
+	masks.space = space;
+	masks.op = op;
+	masks.nonAscii = nonAscii;
+}
+
+#ifdef JSON_INDEXER_X86
+
+__attribute__((target("sse4.2")))
+static void classifySse42(const char* block, BlockMasks& masks) {
+	const __m128i ops = _mm_setr_epi8('{', '}', '[', ']', ':', ',', 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0);
+	const __m128i spaces = _mm_setr_epi8(' ', '\t', '\r', '\n', 0, 0, 0, 0, 0,
+			0, 0, 0, 0, 0, 0, 0);
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+
+	masks.quote = masks.backslash = masks.space = masks.op = masks.nonAscii = 0;
+	for (int i = 0; i < 4; ++i) {
+		__m128i chunk = _mm_loadu_si128((const __m128i*) (block + 16 * i));
+		int shift = 16 * i;
+		// Explicit lengths: the implicit-length forms stop at a NUL byte.
+		Bits op = Bits(
+				_mm_cvtsi128_si32(
+						_mm_cmpestrm(ops, 6, chunk, 16,
+								_SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY
+										| _SIDD_BIT_MASK)) & 0xFFFF);
+		Bits space = Bits(
+				_mm_cvtsi128_si32(
+						_mm_cmpestrm(spaces, 4, chunk, 16,
+								_SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY
+										| _SIDD_BIT_MASK)) & 0xFFFF);
+		Bits q = Bits(
+				_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)) & 0xFFFF);
+		Bits bs = Bits(
+				_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)) & 0xFFFF);
+		masks.op |= op << shift;
+		masks.space |= space << shift;
+		masks.quote |= q << shift;
+		masks.backslash |= bs << shift;
+		masks.nonAscii |= Bits(_mm_movemask_epi8(chunk) & 0xFFFF) << shift;
+	}
+}
+
+__attribute__((target("avx2")))
+static inline Bits movemask32(__m256i mask) {
+	return Bits((unsigned int) _mm256_movemask_epi8(mask));
+}
+
+__attribute__((target("avx2")))
+static void classifyAvx2(const char* block, BlockMasks& masks) {
+	masks.quote = masks.backslash = masks.space = masks.op = masks.nonAscii = 0;
+	for (int i = 0; i < 2; ++i) {
+		__m256i chunk = _mm256_loadu_si256((const __m256i*) (block + 32 * i));
+		int shift = 32 * i;
+		__m256i op = _mm256_or_si256(
+				_mm256_or_si256(
+						_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('{')),
+						_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('}'))),
+				_mm256_or_si256(
+						_mm256_or_si256(
+								_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('[')),
+								_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(']'))),
+						_mm256_or_si256(
+								_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(':')),
+								_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(',')))));
+		__m256i space = _mm256_or_si256(
+				_mm256_or_si256(
+						_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' ')),
+						_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\t'))),
+				_mm256_or_si256(
+						_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\r')),
+						_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n'))));
+		masks.op |= movemask32(op) << shift;
+		masks.space |= movemask32(space) << shift;
+		masks.quote |= movemask32(
+				_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"'))) << shift;
+		masks.backslash |= movemask32(
+				_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\'))) << shift;
+		masks.nonAscii |= movemask32(chunk) << shift;
+	}
+}
+
+#endif // JSON_INDEXER_X86
+
+static ClassifyBlock selectClassifier(const char*& name) {
+#ifdef JSON_INDEXER_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		name = "avx2";
+		return classifyAvx2;
+	}
+	if (__builtin_cpu_supports("sse4.2")) {
+		name = "sse4.2";
+		return classifySse42;
+	}
+#endif
+	name = "scalar";
+	return classifyScalar;
+}
+
+static const char* classifierName = NULL;
+
+static ClassifyBlock classifier() {
+	static ClassifyBlock classify = selectClassifier(classifierName);
+	return classify;
+}
+
+/** Bits of the bytes escaped by a backslash.
+ *
+ * A run of backslashes escapes the byte following it when the run has odd
+ * length. Runs starting on even and odd positions are separated with one
+ * addition; \c prevEscaped carries an escape across block boundaries.
+ */
+static inline Bits findEscaped(Bits backslash, Bits& prevEscaped) {
+	if (backslash == 0) {
+		Bits escaped = prevEscaped;
+		prevEscaped = 0;
+		return escaped;
+	}
+	const Bits evenBits = 0x5555555555555555ULL;
+	backslash &= ~prevEscaped;
+	Bits followsEscape = (backslash << 1) | prevEscaped;
+	Bits oddStarts = backslash & ~evenBits & ~followsEscape;
+	Bits sequencesStartingOnEvenBits = oddStarts + backslash;
+	prevEscaped = sequencesStartingOnEvenBits < oddStarts ? 1 : 0;
+	Bits invertMask = sequencesStartingOnEvenBits << 1;
+	return (evenBits ^ invertMask) & followsEscape;
+}
+
+/// Bit i of the result is the xor of bits [0, i] of \c bits.
+static inline Bits prefixXor(Bits bits) {
+	bits ^= bits << 1;
+	bits ^= bits << 2;
+	bits ^= bits << 4;
+	bits ^= bits << 8;
+	bits ^= bits << 16;
+	bits ^= bits << 32;
+	return bits;
+}
+
+/// A multi-byte UTF-8 sequence being validated, carried across blocks.
+struct Utf8State {
+	/// Continuation bytes still expected.
+	unsigned int pending;
+	/// Range of the next continuation byte.
+	unsigned char low;
+	unsigned char high;
+	/// Offset of the lead byte of the sequence.
+	size_t lead;
+};
+
+/** Start a sequence on the lead byte \c c.
+ *
+ * The range of the first continuation byte rules out overlong forms (after
+ * 0xE0 and 0xF0), UTF-16 surrogates (after 0xED) and code points above
+ * U+10FFFF (after 0xF4); 0x80-0xC1 and 0xF5-0xFF never start a sequence.
+ */
+static inline bool startSequence(unsigned char c, Utf8State& state) {
+	state.low = 0x80;
+	state.high = 0xBF;
+	if (c < 0xC2) {
+		return false;
+	} else if (c < 0xE0) {
+		state.pending = 1;
+	} else if (c < 0xF0) {
+		state.pending = 2;
+		if (c == 0xE0) {
+			state.low = 0xA0;
+		} else if (c == 0xED) {
+			state.high = 0x9F;
+		}
+	} else if (c < 0xF5) {
+		state.pending = 3;
+		if (c == 0xF0) {
+			state.low = 0x90;
+		} else if (c == 0xF4) {
+			state.high = 0x8F;
+		}
+	} else {
+		return false;
+	}
+	return true;
+}
+
+/** Validate a block holding non-ASCII bytes or continuing a sequence.
+ *
+ * Runs of ASCII bytes are jumped over with the \c nonAscii bits, so only
+ * the bytes of multi-byte sequences are looked at one by one.
+ */
+static bool validateBlock(const char* block, Bits nonAscii, size_t base,
+		Utf8State& state) {
+	int i = 0;
+	while (i < 64) {
+		unsigned char c = (unsigned char) block[i];
+		if (state.pending == 0) {
+			Bits rest = nonAscii & (~Bits(0) << i);
+			if (rest == 0) {
+				return true;
+			}
+			i = __builtin_ctzll(rest);
+			c = (unsigned char) block[i];
+			state.lead = base + i;
+			if (!startSequence(c, state)) {
+				return false;
+			}
+		} else {
+			if (c < state.low || c > state.high) {
+				return false;
+			}
+			state.low = 0x80;
+			state.high = 0xBF;
+			--state.pending;
+		}
+		++i;
+	}
+	return true;
+}
+
+/// Bytes indexed by each StructuralIndex::next(), a multiple of 64.
+static const size_t stretchBytes = 16 * 1024;
+
+/// Whether any of the 64 bytes of \c block has the high bit set.
+static inline bool hasNonAscii(const char* block) {
+	Bits any = 0;
+	for (int i = 0; i < 64; i += 8) {
+		Bits word;
+		memcpy(&word, block + i, sizeof(word));
+		any |= word;
+	}
+	return (any & 0x8080808080808080ULL) != 0;
+}
+
+/// Offset of the first invalid UTF-8 sequence of a document, or npos.
+static size_t findInvalidUtf8(const char* begin, size_t length) {
+	ClassifyBlock classify = classifier();
+	Utf8State state;
+	state.pending = 0;
+	char tail[64];
+	for (size_t base = 0; base < length; base += 64) {
+		const char* block = begin + base;
+		if (length - base < 64) {
+			memset(tail, ' ', sizeof(tail));
+			memcpy(tail, block, length - base);
+			block = tail;
+		}
+		// Pure ASCII blocks outside of a sequence cost one test. The spaces
+		// padding the tail end a sequence cut short by the end of input.
+		if (state.pending == 0 && !hasNonAscii(block)) {
+			continue;
+		}
+		BlockMasks masks;
+		classify(block, masks);
+		if (!validateBlock(block, masks.nonAscii, base, state)) {
+			return state.lead;
+		}
+	}
+	return state.pending == 0 ? StructuralIndex::npos : state.lead;
+}
+
+StructuralIndex::StructuralIndex() :
+		document_(NULL), length_(0), offsets_(NULL), capacity_(0), size_(0), windowBegin_(
+				0), scanned_(0), prevEscaped_(0), prevInString_(0), prevScalar_(
+				0), invalidUtf8_(npos) {
+}
+
+StructuralIndex::StructuralIndex(const StructuralIndex& other) :
+		offsets_(NULL), capacity_(0) {
+	*this = other;
+}
+
+StructuralIndex& StructuralIndex::operator=(const StructuralIndex& other) {
+	if (this == &other) {
+		return *this;
+	}
+	if (capacity_ != other.capacity_) {
+		delete[] offsets_;
+		offsets_ = NULL;
+		capacity_ = 0;
+		offsets_ = new Offset[other.capacity_];
+		capacity_ = other.capacity_;
+	}
+	std::copy(other.offsets_, other.offsets_ + other.size_, offsets_);
+	document_ = other.document_;
+	length_ = other.length_;
+	size_ = other.size_;
+	windowBegin_ = other.windowBegin_;
+	scanned_ = other.scanned_;
+	prevEscaped_ = other.prevEscaped_;
+	prevInString_ = other.prevInString_;
+	prevScalar_ = other.prevScalar_;
+	invalidUtf8_ = other.invalidUtf8_;
+	return *this;
+}
+
+StructuralIndex::~StructuralIndex() {
+	delete[] offsets_;
+}
+
+bool StructuralIndex::build(const char* begin, const char* end,
+		bool validateUtf8) {
+	document_ = begin;
+	length_ = size_t(end - begin);
+	invalidUtf8_ = validateUtf8 ? findInvalidUtf8(begin, length_) : npos;
+	if (length_ >= size_t(Offset(-1))) {
+		size_ = 0;
+		windowBegin_ = scanned_ = length_;
+		return false;
+	}
+
+	// A stretch may index each of its bytes. The window is allocated once,
+	// left uninitialised, and no larger than the document needs.
+	size_t capacity = std::min(size_t(windowEntries), (length_ + 63) / 64 * 64);
+	if (capacity > capacity_) {
+		delete[] offsets_;
+		offsets_ = NULL;
+		capacity_ = 0;
+		offsets_ = new Offset[capacity];
+		capacity_ = capacity;
+	}
+	restart(0);
+	return true;
+}
+
+const StructuralIndex::Offset* StructuralIndex::next() {
+	if (scanned_ >= length_) {
+		return NULL;
+	}
+	size_t bytes = std::min(stretchBytes, (length_ - scanned_ + 63) / 64 * 64);
+	if (size_ + bytes > capacity_) {
+		size_ = 0;
+		windowBegin_ = scanned_;
+	}
+	const Offset* added = offsets_ + size_;
+	index(bytes);
+	return added;
+}
+
+void StructuralIndex::restart(size_t offset) {
+	size_ = 0;
+	windowBegin_ = scanned_ = offset;
+	prevEscaped_ = 0;
+	prevInString_ = 0;
+	prevScalar_ = 0;
+	next();
+}
+
+/// Append the offsets of the next \c bytes of the document.
+void StructuralIndex::index(size_t bytes) {
+	ClassifyBlock classify = classifier();
+	Bits prevEscaped = prevEscaped_;
+	Bits prevInString = prevInString_;
+	Bits prevScalar = prevScalar_;
+	char tail[64];
+	Offset* out = offsets_ + size_;
+	size_t stop = std::min(scanned_ + bytes, length_);
+
+	for (size_t base = scanned_; base < stop; base += 64) {
+		const char* block = document_ + base;
+		if (length_ - base < 64) {
+			memset(tail, ' ', sizeof(tail));
+			memcpy(tail, block, length_ - base);
+			block = tail;
+		}
+
+		BlockMasks masks;
+		classify(block, masks);
+
+		Bits quote = masks.quote & ~findEscaped(masks.backslash, prevEscaped);
+		// Set from an opening quote up to, not including, its closing quote.
+		Bits inString = prefixXor(quote) ^ prevInString;
+		prevInString = Bits((long long) inString >> 63);
+
+		// The first byte of numbers, literals and anything unexpected.
+		Bits scalar = ~(masks.space | masks.op | quote);
+		Bits scalarStart = scalar & ~((scalar << 1) | prevScalar);
+		prevScalar = scalar >> 63;
+
+		Bits bits = ((masks.op | scalarStart) & ~inString) | quote;
+		Offset offset = Offset(base);
+		while (bits) {
+			*out++ = offset + Offset(__builtin_ctzll(bits));
+			bits &= bits - 1;
+		}
+	}
+	size_ = size_t(out - offsets_);
+	scanned_ = stop;
+	prevEscaped_ = prevEscaped;
+	prevInString_ = prevInString;
+	prevScalar_ = prevScalar;
+}
+
+void StructuralIndex::clear() {
+	document_ = NULL;
+	length_ = 0;
+	size_ = 0;
+	windowBegin_ = scanned_ = 0;
+}
+
+size_t StructuralIndex::invalidUtf8() const {
+	return invalidUtf8_;
+}
+
+size_t StructuralIndex::size() const {
+	return size_;
+}
+
+const StructuralIndex::Offset* StructuralIndex::begin() const {
+	return offsets_;
+}
+
+const StructuralIndex::Offset* StructuralIndex::end() const {
+	return offsets_ + size_;
+}
+
+size_t StructuralIndex::windowBegin() const {
+	return windowBegin_;
+}
+
+size_t StructuralIndex::windowEnd() const {
+	return scanned_;
+}
+
+const char* StructuralIndex::implementation() {
+	classifier();
+	return classifierName;
+}
+
+} // namespace Json
@@ -0,0 +1,152 @@
+/*
+ * key.cpp
+ *
+ *  Created on: 2026-10-17
+ */
+
+#include "key.h"
+
+namespace Json {
+
+// Class Key
+// //////////////////////////////////////////////////////////////////
+
+Key::Key() :
+		length_(0), storage_(storeInline) {
+}
+
+Key::Key(const char* data, size_t length, Arena* arena) {
+	assign(data, length, arena);
+}
+
+Key::Key(const Key& other) {
+	if (other.storage_ == storeShared) {
+		pointer_ = other.pointer_;
+		length_ = other.length_;
+		storage_ = storeShared;
+	} else {
+		assign(other.data(), other.length_, NULL);
+	}
+}
+
+Key::Key(const Key& other, Arena* arena) {
+	if (other.storage_ == storeShared) {
+		pointer_ = other.pointer_;
+		length_ = other.length_;
+		storage_ = storeShared;
+	} else {
+		assign(other.data(), other.length_, arena);
+	}
+}
+
+Key& Key::operator=(const Key& other) {
+	if (this != &other) {
+		Key copy(other);
+		release();
+		if (copy.storage_ == storeInline) {
+			assign(copy.inline_, copy.length_, NULL);
+		} else {
+			// Take the copy's bytes over.
+			pointer_ = copy.pointer_;
+			length_ = copy.length_;
+			storage_ = copy.storage_;
+			copy.storage_ = storeBorrowed;
+		}
+	}
+	return *this;
+}
+
+Key::~Key() {
+	release();
+}
+
+void Key::swap(Key& other) {
+	char bytes[inlineLength];
+	memcpy(bytes, inline_, inlineLength);
+	memcpy(inline_, other.inline_, inlineLength);
+	memcpy(other.inline_, bytes, inlineLength);
+	UInt length = length_;
+	length_ = other.length_;
+	other.length_ = length;
+	UInt storage = storage_;
+	storage_ = other.storage_;
+	other.storage_ = storage;
+}
+
+Key Key::view(const char* data, size_t length) {
+	Key key;
+	key.pointer_ = data;
+	key.length_ = UInt(length);
+	key.storage_ = storeBorrowed;
+	return key;
+}
+
+void Key::assign(const char* data, size_t length, Arena* arena) {
+	length_ = UInt(length);
+	if (length <= inlineLength) {
+		memcpy(inline_, data, length);
+		storage_ = storeInline;
+		return;
+	}
+	char* bytes;
+	if (arena != NULL) {
+		bytes = static_cast<char*>(arena->allocate(length, 1));
+		storage_ = storeBorrowed;
+	} else {
+		bytes = new char[length];
+		storage_ = storeHeap;
+	}
+	memcpy(bytes, data, length);
+	pointer_ = bytes;
+}
+
+void Key::release() {
+	if (storage_ == storeHeap) {
+		delete[] pointer_;
+	}
+	storage_ = storeInline;
+	length_ = 0;
+}
+
+// Class KeyTable
+// //////////////////////////////////////////////////////////////////
+
+KeyTable::KeyTable() {
+	pthread_rwlock_init(&lock_, NULL);
+}
+
+KeyTable::~KeyTable() {
+	pthread_rwlock_destroy(&lock_);
+}
+
+Key KeyTable::shared(const std::string& name) {
+	Key key;
+	key.pointer_ = name.data();
+	key.length_ = UInt(name.length());
+	key.storage_ = Key::storeShared;
+	return key;
+}
+
+Key KeyTable::intern(const std::string& name) {
+	// Names are mostly known already: look them up under the read lock.
+	// Elements of an unordered_set never move, rehashing included.
+	pthread_rwlock_rdlock(&lock_);
+	Names::const_iterator it = names_.find(name);
+	const std::string* interned = it != names_.end() ? &*it : NULL;
+	pthread_rwlock_unlock(&lock_);
+	if (interned == NULL) {
+		pthread_rwlock_wrlock(&lock_);
+		interned = &*names_.insert(name).first;
+		pthread_rwlock_unlock(&lock_);
+	}
+	return shared(*interned);
+}
+
+size_t KeyTable::size() const {
+	pthread_rwlock_rdlock(&lock_);
+	size_t size = names_.size();
+	pthread_rwlock_unlock(&lock_);
+	return size;
+}
+
+} // namespace Json
@@ -0,0 +1,338 @@
+/*
+ * lazy.cpp
+ *
+ *  Created on: 2026-10-17
+ */
+
+#include "lazy.h"
+
+namespace Json {
+
+// Class LazyDocument
+// //////////////////////////////////////////////////////////////////
+
+LazyDocument::LazyDocument() :
+		root_(NULL) {
+}
+
+bool LazyDocument::parse(const std::string& document) {
+	document_ = document;
+	return parseBorrowed(document_.data(), document_.length());
+}
+
+bool LazyDocument::parseBorrowed(const char* document, size_t length) {
+	error_.clear();
+	root_ = NULL;
+	reader_.start(document, document + length);
+	reader_.skipSpaces();
+
+	Reader::Location current = reader_.current_;
+	if (current != reader_.end_ && (*current == '{' || *current == '[')) {
+		root_ = current;
+		return true;
+	}
+	// The messages of Reader::parse() for an empty or scalar root.
+	if (current == reader_.end_) {
+		error_ = "* " + reader_.getLocationLineAndColumn(current)
+				+ "\n  Syntax error: value, object or array expected.\n";
+	} else {
+		error_ = "* " + reader_.getLocationLineAndColumn(document)
+				+ "\n  A valid JSON document must be either an array or an object value.\n";
+	}
+	return false;
+}
+
+LazyValue LazyDocument::root() {
+	return LazyValue(this, root_);
+}
+
+std::string LazyDocument::getFormattedErrorMessages() const {
+	return error_;
+}
+
+bool LazyDocument::good() const {
+	return error_.empty();
+}
+
+/** The member of \c object named [key, key + length), or NULL. As with
+ * Reader::parse(), the last one wins if the name repeats: the whole object
+ * is read.
+ */
+const char* LazyDocument::find(const char* object, const char* key,
+		size_t length) {
+	const char* next = open(object);
+	const char* value;
+	const char* found = NULL;
+	while (next != NULL) {
+		if (!nextChild(next, true, &name_, value)) {
+			return NULL;
+		}
+		if (name_.length() == length
+				&& memcmp(name_.data(), key, length) == 0) {
+			found = value;
+		}
+	}
+	return found;
+}
+
+/// Where the first element or member of \c container starts, NULL if none.
+const char* LazyDocument::open(const char* container) {
+	if (container == NULL || (*container != '{' && *container != '[')) {
+		return NULL;
+	}
+	reader_.seek(container + 1);
+	reader_.skipSpaces();
+	Reader::Location current = reader_.current_;
+	// An empty container has nothing to visit.
+	if (current == reader_.end_ || *current == (*container == '{' ? '}' : ']')) {
+		return NULL;
+	}
+	return current;
+}
+
+/** Read the element or member starting at \c next, skipping its value.
+ * \c next moves to the one after it, or to NULL after the last one.
+ * \return \c false, with \c next NULL, if the bytes are malformed.
+ */
+bool LazyDocument::nextChild(const char*& next, bool object, std::string* name,
+		const char*& value) {
+	Reader::Token token;
+	reader_.seek(next);
+	next = NULL;
+
+	if (object) {
+		reader_.readToken(token);
+		if (token.type_ == Reader::tokenString) {
+			// Keys without escapes are copied as they are.
+			Reader::Location begin = token.start_ + 1;
+			size_t length = token.end_ - token.start_ - 2;
+			if (memchr(begin, '\\', length) == NULL) {
+				name->assign(begin, length);
+			} else {
+				name->clear();
+				if (!reader_.decodeString(token, *name)) {
+					return false;
+				}
+			}
+		} else if (token.type_ == Reader::tokenNumber) {
+			Value numberName;
+			if (!reader_.decodeNumber(token, numberName)) {
+				return false;
+			}
+			*name = numberName.asString();
+		} else {
+			return false;
+		}
+		reader_.readToken(token);
+		if (token.type_ != Reader::tokenMemberSeparator) {
+			return false;
+		}
+	}
+
+	reader_.skipSpaces();
+	value = reader_.current_;
+	if (!reader_.skipValue()) {
+		return false;
+	}
+	reader_.readToken(token);
+	if (token.type_ == Reader::tokenArraySeparator) {
+		next = reader_.current_;
+		return true;
+	}
+	return token.type_ == (object ? Reader::tokenObjectEnd : Reader::tokenArrayEnd);
+}
+
+bool LazyDocument::decode(const char* value, Value& decoded) {
+	if (value != NULL && reader_.decodeValue(value, decoded)) {
+		return true;
+	}
+	Value null;
+	decoded.swap(null);
+	return false;
+}
+
+// Class LazyIterator
+// //////////////////////////////////////////////////////////////////
+
+LazyIterator::LazyIterator(LazyDocument* document, const char* container) :
+		document_(document), next_(NULL), object_(false) {
+	if (document_ != NULL) {
+		object_ = *container == '{';
+		next_ = document_->open(container);
+	}
+}
+
+bool LazyIterator::next() {
+	const char* value = NULL;
+	if (next_ == NULL
+			|| !document_->nextChild(next_, object_, &name_, value)) {
+		next_ = NULL;
+		value_ = LazyValue();
+		return false;
+	}
+	value_ = LazyValue(document_, value);
+	return true;
+}
+
+const std::string& LazyIterator::name() const {
+	return name_;
+}
+
+LazyValue LazyIterator::value() const {
+	return value_;
+}
+
+// Class LazyValue
+// //////////////////////////////////////////////////////////////////
+
+LazyValue::LazyValue() :
+		document_(NULL), start_(NULL) {
+}
+
+LazyValue::LazyValue(LazyDocument* document, const char* start) :
+		document_(document), start_(start) {
+	if (start_ == NULL) {
+		document_ = NULL;
+	}
+}
+
+ValueType LazyValue::type() const {
+	if (start_ == NULL) {
+		return nullValue;
+	}
+	switch (*start_) {
+	case '{':
+		return objectValue;
+	case '[':
+		return arrayValue;
+	case '"':
+		return stringValue;
+	case 't':
+	case 'f':
+		return booleanValue;
+	case '-':
+	case '0':
+	case '1':
+	case '2':
+	case '3':
+	case '4':
+	case '5':
+	case '6':
+	case '7':
+	case '8':
+	case '9':
+		// Whether it is an integer is only known once decoded.
+		return toValue().type();
+	default:
+		return nullValue;
+	}
+}
+
+bool LazyValue::isNull() const {
+	return type() == nullValue;
+}
+
+bool LazyValue::isBool() const {
+	return type() == booleanValue;
+}
+
+bool LazyValue::isNumeric() const {
+	ValueType valueType = type();
+	return valueType == intValue || valueType == uintValue
+			|| valueType == realValue;
+}
+
+bool LazyValue::isString() const {
+	return type() == stringValue;
+}
+
+bool LazyValue::isArray() const {
+	return start_ != NULL && *start_ == '[';
+}
+
+bool LazyValue::isObject() const {
+	return start_ != NULL && *start_ == '{';
+}
+
+LazyValue LazyValue::operator[](const char* key) const {
+	if (!isObject()) {
+		return LazyValue();
+	}
+	return LazyValue(document_, document_->find(start_, key, strlen(key)));
+}
+
+LazyValue LazyValue::operator[](const std::string& key) const {
+	if (!isObject()) {
+		return LazyValue();
+	}
+	return LazyValue(document_,
+			document_->find(start_, key.data(), key.length()));
+}
+
+LazyValue LazyValue::operator[](ArrayIndex index) const {
+	if (!isArray()) {
+		return LazyValue();
+	}
+	LazyIterator it = iterate();
+	while (it.next()) {
+		if (index-- == 0) {
+			return it.value();
+		}
+	}
+	return LazyValue();
+}
+
+bool LazyValue::isMember(const char* key) const {
+	return (*this)[key].start_ != NULL;
+}
+
+ArrayIndex LazyValue::size() const {
+	ArrayIndex size = 0;
+	LazyIterator it = iterate();
+	while (it.next()) {
+		++size;
+	}
+	return size;
+}
+
+LazyIterator LazyValue::iterate() const {
+	return LazyIterator(document_, start_);
+}
+
+std::string LazyValue::asString() const {
+	return toValue().asString();
+}
+
+Int LazyValue::asInt() const {
+	return toValue().asInt();
+}
+
+UInt LazyValue::asUInt() const {
+	return toValue().asUInt();
+}
+
+Int64 LazyValue::asInt64() const {
+	return toValue().asInt64();
+}
+
+UInt64 LazyValue::asUInt64() const {
+	return toValue().asUInt64();
+}
+
+double LazyValue::asDouble() const {
+	return toValue().asDouble();
+}
+
+bool LazyValue::asBool() const {
+	return toValue().asBool();
+}
+
+Value LazyValue::toValue() const {
+	Value decoded;
+	if (document_ != NULL) {
+		document_->decode(start_, decoded);
+	}
+	return decoded;
+}
+
+} // namespace Json
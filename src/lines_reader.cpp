@@ -0,0 +1,243 @@
+/*
+ * lines_reader.cpp
+ *
+ *  Created on: 2026-10-17
+ */
+
+#include "lines_reader.h"
+#include <pthread.h>
+#include <unistd.h>
+
+namespace Json {
+
+/// Bytes handed to a worker at a time, rounded up to a whole line.
+static const size_t batchBytes = 1 << 20;
+
+/// A run of whole lines and what parsing them produced.
+class LinesReader::Batch {
+public:
+	const char* begin_;
+	const char* end_;
+	/// Line breaks in the batch, to number the lines of the next ones.
+	size_t lines_;
+	std::vector<Value> values_;
+	/// Errors with a line number relative to the batch.
+	Errors errors_;
+};
+
+/// State shared by the workers of one parse.
+class LinesReader::Job {
+public:
+	const char* begin_;
+	std::vector<Batch>* batches_;
+	Consumer* consumer_;
+	size_t next_;
+	pthread_mutex_t mutex_;
+};
+
+LinesReader::Consumer::~Consumer() {
+}
+
+LinesReader::LinesReader(int threads) :
+		threads_(threads) {
+	if (threads_ <= 0) {
+		long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		threads_ = cpus > 0 ? int(cpus) : 1;
+	}
+}
+
+int LinesReader::threads() const {
+	return threads_;
+}
+
+bool LinesReader::parse(const std::string& document,
+		std::vector<Value>& records) {
+	return parse(document.data(), document.data() + document.length(),
+			records);
+}
+
+bool LinesReader::parse(const char* beginDoc, const char* endDoc,
+		std::vector<Value>& records) {
+	std::vector<Batch> batches;
+	bool ok = run(beginDoc, endDoc, batches, NULL);
+
+	size_t count = 0;
+	for (size_t i = 0; i < batches.size(); ++i) {
+		count += batches[i].values_.size();
+	}
+	// Values are swapped into place: growing a vector would deep copy them.
+	records.clear();
+	records.resize(count);
+	std::vector<Value>::iterator out = records.begin();
+	for (size_t i = 0; i < batches.size(); ++i) {
+		std::vector<Value>& values = batches[i].values_;
+		for (size_t j = 0; j < values.size(); ++j, ++out) {
+			out->swap(values[j]);
+		}
+	}
+	return ok;
+}
+
+bool LinesReader::parse(const char* beginDoc, const char* endDoc,
+		Consumer& consumer) {
+	std::vector<Batch> batches;
+	return run(beginDoc, endDoc, batches, &consumer);
+}
+
+bool LinesReader::run(const char* beginDoc, const char* endDoc,
+		std::vector<Batch>& batches, Consumer* consumer) {
+	errors_.clear();
+
+	for (const char* current = beginDoc; current != endDoc;) {
+		Batch batch;
+		batch.begin_ = current;
+		batch.lines_ = 0;
+		if (size_t(endDoc - current) <= batchBytes) {
+			current = endDoc;
+		} else {
+			const char* lineEnd = (const char*) memchr(current + batchBytes,
+					'\n', endDoc - current - batchBytes);
+			current = lineEnd ? lineEnd + 1 : endDoc;
+		}
+		batch.end_ = current;
+		batches.push_back(batch);
+	}
+
+	Job job;
+	job.begin_ = beginDoc;
+	job.batches_ = &batches;
+	job.consumer_ = consumer;
+	job.next_ = 0;
+	pthread_mutex_init(&job.mutex_, NULL);
+
+	// The calling thread works too; if a thread cannot be started the
+	// others simply take its share.
+	std::vector<pthread_t> workers;
+	size_t threads = std::min(size_t(threads_), batches.size());
+	for (size_t i = 1; i < threads; ++i) {
+		pthread_t worker;
+		if (pthread_create(&worker, NULL, work, &job) == 0) {
+			workers.push_back(worker);
+		}
+	}
+	work(&job);
+	for (size_t i = 0; i < workers.size(); ++i) {
+		pthread_join(workers[i], NULL);
+	}
+	pthread_mutex_destroy(&job.mutex_);
+
+	size_t line = 0;
+	for (size_t i = 0; i < batches.size(); ++i) {
+		Errors& errors = batches[i].errors_;
+		for (size_t j = 0; j < errors.size(); ++j) {
+			errors_.push_back(errors[j]);
+			errors_.back().line_ += line;
+		}
+		line += batches[i].lines_;
+	}
+	return errors_.empty();
+}
+
+void* LinesReader::work(void* data) {
+	Job& job = *static_cast<Job*>(data);
+	Reader reader;
+	for (;;) {
+		pthread_mutex_lock(&job.mutex_);
+		size_t index = job.next_++;
+		pthread_mutex_unlock(&job.mutex_);
+		if (index >= job.batches_->size()) {
+			return NULL;
+		}
+		parseBatch(reader, (*job.batches_)[index], job);
+	}
+}
+
+void LinesReader::parseBatch(Reader& reader, Batch& batch, Job& job) {
+	if (job.consumer_ == NULL) {
+		// One slot per line at most, so that values are never copied.
+		size_t lines = std::count(batch.begin_, batch.end_, '\n');
+		batch.values_.resize(lines + 1);
+	}
+	size_t records = 0;
+	Value value;
+
+	for (const char* current = batch.begin_; current != batch.end_;) {
+		const char* lineEnd = (const char*) memchr(current, '\n',
+				batch.end_ - current);
+		const char* next = lineEnd ? lineEnd + 1 : batch.end_;
+		if (lineEnd == NULL) {
+			lineEnd = batch.end_;
+		}
+		if (lineEnd != current && lineEnd[-1] == '\r') {
+			--lineEnd;
+		}
+		const char* first = current;
+		while (first != lineEnd
+				&& (*first == ' ' || *first == '\t' || *first == '\r')) {
+			++first;
+		}
+
+		if (first != lineEnd) {
+			if (reader.parse(current, lineEnd, value)) {
+				if (job.consumer_ != NULL) {
+					job.consumer_->record(current - job.begin_, value);
+				}
+			} else {
+				for (Reader::Errors::const_iterator itError =
+						reader.errors_.begin(); itError != reader.errors_.end();
+						++itError) {
+					int line, column;
+					reader.getLocationLineAndColumn(itError->token_.start_, line,
+							column);
+					ErrorInfo error;
+					error.line_ = batch.lines_ + line;
+					error.column_ = column;
+					error.message_ = itError->message_;
+					batch.errors_.push_back(error);
+				}
+				Value null;
+				value.swap(null);
+			}
+			if (job.consumer_ == NULL) {
+				batch.values_[records++].swap(value);
+			}
+		}
+
+		if (next[-1] == '\n') {
+			++batch.lines_;
+		}
+		current = next;
+	}
+
+	if (job.consumer_ == NULL) {
+		batch.values_.resize(records);
+	}
+}
+
+std::string LinesReader::getFormattedErrorMessages() const {
+	std::string formattedMessage;
+	for (Errors::const_iterator itError = errors_.begin();
+			itError != errors_.end(); ++itError) {
+		char buffer[18 + 32 + 16 + 1];
+		snprintf(buffer, sizeof(buffer), "Line %lu, Column %d",
+				(unsigned long) itError->line_, itError->column_);
+		formattedMessage += std::string("* ") + buffer + "\n";
+		formattedMessage += "  " + itError->message_ + "\n";
+	}
+	return formattedMessage;
+}
+
+std::vector<std::string> LinesReader::getStructuredErrors() const {
+	std::vector<std::string> allErrors;
+	for (Errors::const_iterator itError = errors_.begin();
+			itError != errors_.end(); ++itError) {
+		allErrors.push_back(itError->message_);
+	}
+	return allErrors;
+}
+
+bool LinesReader::good() const {
+	return errors_.empty();
+}
+
+} // namespace Json
@@ -0,0 +1,362 @@
+/*
+ * object_table.cpp
+ *
+ *  Created on: 2026-10-17
+ */
+
+#include "object_table.h"
+
+namespace Json {
+
+/// Hash of a member name, eight bytes at a time.
+static inline UInt hashName(const char* data, size_t length) {
+	UInt64 hash = 0x9E3779B97F4A7C15ULL ^ length;
+	while (length >= 8) {
+		UInt64 word;
+		memcpy(&word, data, 8);
+		hash = (hash ^ word) * 0xFF51AFD7ED558CCDULL;
+		hash ^= hash >> 32;
+		data += 8;
+		length -= 8;
+	}
+	UInt64 word = 0;
+	memcpy(&word, data, length);
+	hash = (hash ^ word) * 0xC4CEB9FE1A85EC53ULL;
+	hash ^= hash >> 29;
+	return UInt(hash);
+}
+
+static inline UInt hashName(const Key& key) {
+	return hashName(key.data(), key.length());
+}
+
+// Class ObjectTable
+// //////////////////////////////////////////////////////////////////
+
+ObjectTable::ObjectTable(const allocator_type& allocator) :
+		allocator_(allocator), blocks_(NULL), members_(NULL), slots_(NULL), size_(
+				0), capacity_(0), mask_(0) {
+}
+
+ObjectTable::ObjectTable(const ObjectTable& other) :
+		allocator_(other.allocator_.select_on_container_copy_construction()), blocks_(
+				NULL), members_(NULL), slots_(NULL), size_(0), capacity_(0), mask_(
+				0) {
+	*this = other;
+}
+
+ObjectTable& ObjectTable::operator=(const ObjectTable& other) {
+	if (this == &other) {
+		return *this;
+	}
+	clear();
+	reserve(other.size_);
+	if (slots_ == NULL && other.size_ > smallSize) {
+		createSlots();
+	}
+	for (const_iterator it = other.begin(); it != other.end(); ++it) {
+		UInt hash = slots_ != NULL ? hashName(it->first) : 0;
+		append(it->first, hash).second = it->second;
+	}
+	return *this;
+}
+
+ObjectTable::~ObjectTable() {
+	clear();
+	while (blocks_ != NULL) {
+		Block* block = blocks_;
+		blocks_ = block->next_;
+		allocator_.deallocate(reinterpret_cast<ObjectMember*>(block),
+				block->size_);
+	}
+	if (slots_ != NULL) {
+		SlotAllocator(allocator_).deallocate(slots_, mask_ + 1);
+	}
+}
+
+ObjectTable::iterator ObjectTable::find(const Key& key) {
+	UInt hash;
+	return iterator(members_ + lookup(key, hash));
+}
+
+ObjectTable::const_iterator ObjectTable::find(const Key& key) const {
+	UInt hash;
+	return const_iterator(members_ + lookup(key, hash));
+}
+
+Value& ObjectTable::operator[](const Key& key) {
+	return try_emplace(key).first->second;
+}
+
+std::pair<ObjectTable::iterator, bool> ObjectTable::try_emplace(
+		const Key& key) {
+	UInt hash;
+	size_t position = lookup(key, hash);
+	if (position != size_) {
+		return std::make_pair(iterator(members_ + position), false);
+	}
+	append(key, hash);
+	return std::make_pair(iterator(members_ + size_ - 1), true);
+}
+
+ObjectTable::iterator ObjectTable::erase(iterator position) {
+	size_t index = position.position_ - members_;
+	ObjectMember* member = members_[index];
+	if (slots_ != NULL) {
+		removeSlot(index);
+	}
+	member->~ObjectMember();
+	std::copy(members_ + index + 1, members_ + size_, members_ + index);
+	--size_;
+	members_[size_] = member;
+	return iterator(members_ + index);
+}
+
+void ObjectTable::clear() {
+	for (size_t i = 0; i < size_; ++i) {
+		members_[i]->~ObjectMember();
+	}
+	size_ = 0;
+	if (slots_ != NULL) {
+		memset(slots_, 0, (mask_ + 1) * sizeof(Slot));
+	}
+}
+
+void ObjectTable::reserve(size_t count) {
+	if (count <= capacity_) {
+		return;
+	}
+	size_t capacity = capacity_ == 0 ? minimumCapacity : capacity_;
+	while (capacity < count) {
+		capacity *= 2;
+	}
+
+	// One allocation holds the block, the storage of the members added and
+	// the new pointer array. Members stay where they are; the old array is
+	// only freed with its block.
+	static_assert(sizeof(Block) <= sizeof(ObjectMember),
+			"a Block must fit in the storage of a member");
+	size_t added = capacity - capacity_;
+	size_t pointers = (capacity * sizeof(ObjectMember*) + sizeof(ObjectMember)
+			- 1) / sizeof(ObjectMember);
+	size_t size = 1 + added + pointers;
+	ObjectMember* storage = allocator_.allocate(size);
+	Block* block = reinterpret_cast<Block*>(storage);
+	block->next_ = blocks_;
+	block->size_ = size;
+	blocks_ = block;
+
+	ObjectMember** members = reinterpret_cast<ObjectMember**>(storage + 1
+			+ added);
+	std::copy(members_, members_ + capacity_, members);
+	for (size_t i = 0; i < added; ++i) {
+		members[capacity_ + i] = storage + 1 + i;
+	}
+	members_ = members;
+	capacity_ = capacity;
+	if (slots_ == NULL) {
+		return;
+	}
+
+	// Members keep their positions: the slots only need spreading out.
+	SlotAllocator slotAllocator(allocator_);
+	Slot* oldSlots = slots_;
+	size_t oldSlotCount = mask_ + 1;
+	slots_ = slotAllocator.allocate(capacity * 2);
+	memset(slots_, 0, capacity * 2 * sizeof(Slot));
+	mask_ = capacity * 2 - 1;
+	for (size_t i = 0; i < oldSlotCount; ++i) {
+		if (oldSlots[i].member_ != 0) {
+			insertSlot(oldSlots[i].hash_, oldSlots[i].member_);
+		}
+	}
+	slotAllocator.deallocate(oldSlots, oldSlotCount);
+}
+
+Value& ObjectTable::claim(const Key& key, size_t& claimed) {
+	UInt hash;
+	size_t position = lookup(key, hash);
+	if (position == size_) {
+		append(key, hash);
+	}
+	if (position < claimed) {
+		// Repeated in the new document.
+		return members_[position]->second;
+	}
+	if (position != claimed) {
+		swapMembers(position, claimed);
+	}
+	return members_[claimed++]->second;
+}
+
+void ObjectTable::truncate(size_t count) {
+	if (count >= size_) {
+		return;
+	}
+	for (size_t i = count; i < size_; ++i) {
+		members_[i]->~ObjectMember();
+	}
+	size_ = count;
+	rehash();
+}
+
+bool ObjectTable::operator==(const ObjectTable& other) const {
+	if (size_ != other.size_) {
+		return false;
+	}
+	for (size_t i = 0; i < size_; ++i) {
+		const_iterator it = other.find(members_[i]->first);
+		if (it == other.end() || !(it->second == members_[i]->second)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool nameLess(const ObjectMember* a, const ObjectMember* b) {
+	return a->first < b->first;
+}
+
+/// The members of \c table, sorted by name.
+static void sortedMembers(const ObjectTable& table,
+		std::vector<const ObjectMember*>& sorted) {
+	sorted.reserve(table.size());
+	for (ObjectTable::const_iterator it = table.begin(); it != table.end();
+			++it) {
+		sorted.push_back(&*it);
+	}
+	std::sort(sorted.begin(), sorted.end(), nameLess);
+}
+
+bool ObjectTable::operator<(const ObjectTable& other) const {
+	std::vector<const ObjectMember*> mine;
+	std::vector<const ObjectMember*> theirs;
+	sortedMembers(*this, mine);
+	sortedMembers(other, theirs);
+	size_t count = std::min(mine.size(), theirs.size());
+	for (size_t i = 0; i < count; ++i) {
+		if (mine[i]->first < theirs[i]->first) {
+			return true;
+		}
+		if (theirs[i]->first < mine[i]->first) {
+			return false;
+		}
+		if (mine[i]->second < theirs[i]->second) {
+			return true;
+		}
+		if (theirs[i]->second < mine[i]->second) {
+			return false;
+		}
+	}
+	return mine.size() < theirs.size();
+}
+
+/// Position of the member named \c key, or size_ if there is none. The
+/// hash of the name is computed only if there are slots to probe.
+size_t ObjectTable::lookup(const Key& key, UInt& hash) const {
+	if (slots_ == NULL) {
+		// Key::operator==() compares the lengths first.
+		for (size_t i = 0; i < size_; ++i) {
+			if (members_[i]->first == key) {
+				return i;
+			}
+		}
+		return size_;
+	}
+	hash = hashName(key);
+	for (size_t slot = hash & mask_;; slot = (slot + 1) & mask_) {
+		const Slot& probe = slots_[slot];
+		if (probe.member_ == 0) {
+			return size_;
+		}
+		if (probe.hash_ == hash && members_[probe.member_ - 1]->first == key) {
+			return probe.member_ - 1;
+		}
+	}
+}
+
+ObjectMember& ObjectTable::append(const Key& key, UInt hash) {
+	if (size_ == capacity_) {
+		reserve(size_ + 1);
+	}
+	ObjectMember* member = new (members_[size_]) ObjectMember(key,
+			allocator_.arena());
+	++size_;
+	if (slots_ != NULL) {
+		insertSlot(hash, size_);
+	} else if (size_ > smallSize) {
+		createSlots();
+	}
+	return *member;
+}
+
+/// Index the members once the object is too large to scan.
+void ObjectTable::createSlots() {
+	slots_ = SlotAllocator(allocator_).allocate(capacity_ * 2);
+	mask_ = capacity_ * 2 - 1;
+	rehash();
+}
+
+/// Record that \c member, a position plus one, has the hash \c hash.
+void ObjectTable::insertSlot(UInt hash, size_t member) {
+	size_t slot = hash & mask_;
+	while (slots_[slot].member_ != 0) {
+		slot = (slot + 1) & mask_;
+	}
+	slots_[slot].hash_ = hash;
+	slots_[slot].member_ = UInt(member);
+}
+
+ObjectTable::Slot& ObjectTable::slotOf(size_t position) {
+	size_t slot = hashName(members_[position]->first) & mask_;
+	while (slots_[slot].member_ != position + 1) {
+		slot = (slot + 1) & mask_;
+	}
+	return slots_[slot];
+}
+
+/// Drop the slot of the member at \c position and renumber the members
+/// that follow it, which move down by one.
+void ObjectTable::removeSlot(size_t position) {
+	// Backward-shift deletion: pull each following slot of the cluster into
+	// the hole unless that would put it before its home slot.
+	size_t hole = &slotOf(position) - slots_;
+	for (size_t next = (hole + 1) & mask_; slots_[next].member_ != 0;
+			next = (next + 1) & mask_) {
+		size_t home = slots_[next].hash_ & mask_;
+		if (((next - home) & mask_) >= ((next - hole) & mask_)) {
+			slots_[hole] = slots_[next];
+			hole = next;
+		}
+	}
+	slots_[hole].member_ = 0;
+
+	if (position + 1 == size_) {
+		return;
+	}
+	// Branch-free, so that the compiler vectorizes the pass.
+	UInt removed = UInt(position + 1);
+	for (size_t slot = 0; slot <= mask_; ++slot) {
+		slots_[slot].member_ -= UInt(slots_[slot].member_ > removed);
+	}
+}
+
+void ObjectTable::swapMembers(size_t a, size_t b) {
+	if (slots_ != NULL) {
+		std::swap(slotOf(a).member_, slotOf(b).member_);
+	}
+	std::swap(members_[a], members_[b]);
+}
+
+/// Rebuild the slots after members moved.
+void ObjectTable::rehash() {
+	if (slots_ == NULL) {
+		return;
+	}
+	memset(slots_, 0, (mask_ + 1) * sizeof(Slot));
+	for (size_t i = 0; i < size_; ++i) {
+		insertSlot(hashName(members_[i]->first), i + 1);
+	}
+}
+
+} // namespace Json
@@ -0,0 +1,511 @@
+/*
+ * push_reader.cpp
+ *
+ *  Created on: 2026-10-17
+ */
+
+#include "push_reader.h"
+
+namespace Json {
+
+// Class PushReader
+// //////////////////////////////////////////////////////////////////
+
+PushReader::PushReader(Handler& handler) :
+		handler_(&handler), builder_(NULL) {
+	reset();
+}
+
+PushReader::PushReader(Value& root) :
+		handler_(NULL), builder_(new ValueBuilder(root)) {
+	handler_ = builder_;
+	reset();
+}
+
+PushReader::~PushReader() {
+	delete builder_;
+}
+
+void PushReader::reset() {
+	frames_.clear();
+	token_.clear();
+	name_.clear();
+	error_.clear();
+	expect_ = expectRoot;
+	lexer_ = lexNone;
+	numberPart_ = numberInteger;
+	literal_ = NULL;
+	literalType_ = Reader::tokenError;
+	escaped_ = false;
+	failed_ = false;
+	afterCarriageReturn_ = false;
+	offset_ = 0;
+	lineStart_ = 0;
+	line_ = 1;
+	tokenLine_ = tokenColumn_ = 0;
+	errorLine_ = errorColumn_ = 0;
+	if (builder_ != NULL) {
+		builder_->reset();
+	}
+}
+
+bool PushReader::feed(const std::string& data) {
+	return feed(data.data(), data.length());
+}
+
+bool PushReader::feed(const char* data, size_t length) {
+	for (const char* end = data + length; data != end && !failed_; ++data) {
+		char c = *data;
+		switch (lexer_) {
+		case lexString:
+			token_ += c;
+			if (escaped_) {
+				escaped_ = false;
+			} else if (c == '\\') {
+				escaped_ = true;
+			} else if (c == '"') {
+				lexer_ = lexNone;
+				readToken(Reader::tokenString);
+			}
+			break;
+		case lexNumber:
+			if (continueNumber(c)) {
+				token_ += c;
+				break;
+			}
+			lexer_ = lexNone;
+			if (!readToken(Reader::tokenNumber) || lexer_ == lexDone) {
+				break;
+			}
+			startToken(c);
+			break;
+		case lexLiteral:
+			if (c != *literal_) {
+				// Like Reader::match(), a mismatch is an error token.
+				lexer_ = lexNone;
+				readToken(Reader::tokenError);
+			} else if (*++literal_ == 0) {
+				lexer_ = lexNone;
+				readToken(literalType_);
+			}
+			break;
+		case lexNone:
+			startToken(c);
+			break;
+		case lexDone:
+			// Bytes after the root value are ignored, as Reader does.
+			return good();
+		}
+
+		++offset_;
+		if (c == '\r') {
+			++line_;
+			lineStart_ = offset_;
+			afterCarriageReturn_ = true;
+		} else {
+			if (c == '\n') {
+				// "\r\n" ends a single line.
+				if (!afterCarriageReturn_) {
+					++line_;
+				}
+				lineStart_ = offset_;
+			}
+			afterCarriageReturn_ = false;
+		}
+	}
+	return good();
+}
+
+bool PushReader::finish() {
+	if (failed_ || lexer_ == lexDone) {
+		return good();
+	}
+	switch (lexer_) {
+	case lexNumber:
+		lexer_ = lexNone;
+		if (!readToken(Reader::tokenNumber) || lexer_ == lexDone) {
+			return good();
+		}
+		break;
+	case lexString:
+	case lexLiteral:
+		// Unterminated string or truncated literal.
+		lexer_ = lexNone;
+		readToken(Reader::tokenError);
+		return good();
+	default:
+		break;
+	}
+	tokenLine_ = line_;
+	tokenColumn_ = int(offset_ - lineStart_) + 1;
+	readToken(Reader::tokenEndOfStream);
+	return good();
+}
+
+bool PushReader::done() const {
+	return lexer_ == lexDone;
+}
+
+void PushReader::setStackLimit(unsigned int limit) {
+	decoder_.setStackLimit(limit);
+}
+
+unsigned int PushReader::stackLimit() const {
+	return decoder_.stackLimit();
+}
+
+void PushReader::startToken(char c) {
+	tokenLine_ = line_;
+	tokenColumn_ = int(offset_ - lineStart_) + 1;
+	switch (c) {
+	case ' ':
+	case '\t':
+	case '\r':
+	case '\n':
+		return;
+	case '{':
+		readToken(Reader::tokenObjectBegin);
+		return;
+	case '}':
+		readToken(Reader::tokenObjectEnd);
+		return;
+	case '[':
+		readToken(Reader::tokenArrayBegin);
+		return;
+	case ']':
+		readToken(Reader::tokenArrayEnd);
+		return;
+	case ',':
+		readToken(Reader::tokenArraySeparator);
+		return;
+	case ':':
+		readToken(Reader::tokenMemberSeparator);
+		return;
+	case '"':
+		token_.assign(1, c);
+		escaped_ = false;
+		lexer_ = lexString;
+		return;
+	case '0':
+	case '1':
+	case '2':
+	case '3':
+	case '4':
+	case '5':
+	case '6':
+	case '7':
+	case '8':
+	case '9':
+	case '-':
+		token_.assign(1, c);
+		numberPart_ = numberInteger;
+		lexer_ = lexNumber;
+		return;
+	case 't':
+		literal_ = "rue";
+		literalType_ = Reader::tokenTrue;
+		lexer_ = lexLiteral;
+		return;
+	case 'f':
+		literal_ = "alse";
+		literalType_ = Reader::tokenFalse;
+		lexer_ = lexLiteral;
+		return;
+	case 'n':
+		literal_ = "ull";
+		literalType_ = Reader::tokenNull;
+		lexer_ = lexLiteral;
+		return;
+	case 0:
+		readToken(Reader::tokenEndOfStream);
+		return;
+	default:
+		readToken(Reader::tokenError);
+		return;
+	}
+}
+
+/// Same number syntax as Reader::readNumber(), one byte at a time.
+bool PushReader::continueNumber(char c) {
+	bool digit = c >= '0' && c <= '9';
+	switch (numberPart_) {
+	case numberInteger:
+		if (c == '.') {
+			numberPart_ = numberFraction;
+			return true;
+		}
+		// fall through
+	case numberFraction:
+		if (c == 'e' || c == 'E') {
+			numberPart_ = numberExponentSign;
+			return true;
+		}
+		return digit;
+	case numberExponentSign:
+		numberPart_ = numberExponent;
+		return digit || c == '+' || c == '-';
+	case numberExponent:
+		return digit;
+	}
+	return false;
+}
+
+/// Advance the grammar by one token, mirroring Reader::readValue() & co.
+bool PushReader::readToken(TokenType type) {
+	switch (expect_) {
+	case expectRoot:
+		return readRoot(type);
+	case expectFirstElement:
+		if (type == Reader::tokenArrayEnd) {
+			return endContainer();
+		}
+		return readValue(type);
+	case expectValue:
+		return readValue(type);
+	case expectElementSeparator:
+		if (type == Reader::tokenArraySeparator) {
+			expect_ = expectValue;
+			return true;
+		}
+		if (type == Reader::tokenArrayEnd) {
+			return endContainer();
+		}
+		return addError("Missing ',' or ']' in array declaration");
+	case expectName:
+		return readName(type);
+	case expectNameSeparator:
+		if (type != Reader::tokenMemberSeparator) {
+			return addError("Missing ':' after object member name");
+		}
+		expect_ = expectValue;
+		return accept(handler_->key(name_.data(), name_.length()));
+	case expectMemberSeparator:
+		if (type == Reader::tokenArraySeparator) {
+			expect_ = expectName;
+			return true;
+		}
+		if (type == Reader::tokenObjectEnd) {
+			return endContainer();
+		}
+		return addError("Missing ',' or '}' in object declaration");
+	}
+	return false;
+}
+
+/** Reject a root that is not a container, after reading it as
+ * Reader::parse() does: errors within the value are reported first. A
+ * scalar root produces no event.
+ */
+bool PushReader::readRoot(TokenType type) {
+	Reader::Token token;
+	token.start_ = token_.data();
+	token.end_ = token_.data() + token_.length();
+	Value decoded;
+	switch (type) {
+	case Reader::tokenObjectBegin:
+	case Reader::tokenArrayBegin:
+		return readValue(type);
+	case Reader::tokenNumber:
+		if (!decoder_.decodeNumber(token, decoded)) {
+			return decodeError();
+		}
+		break;
+	case Reader::tokenString:
+		decoded_.clear();
+		if (!decodeString(decoded_)) {
+			return false;
+		}
+		break;
+	case Reader::tokenMemberSeparator:
+	case Reader::tokenEndOfStream:
+	case Reader::tokenError:
+		return addError("Syntax error: value, object or array expected.");
+	default:
+		// Literals, and the tokens Reader reads as a missing value.
+		break;
+	}
+	return addError(
+			"A valid JSON document must be either an array or an object value.",
+			1, 1);
+}
+
+bool PushReader::readValue(TokenType type) {
+	switch (type) {
+	case Reader::tokenObjectBegin:
+		if (!openContainer(true)) {
+			return false;
+		}
+		expect_ = expectName;
+		return accept(handler_->startObject());
+	case Reader::tokenArrayBegin:
+		if (!openContainer(false)) {
+			return false;
+		}
+		expect_ = expectFirstElement;
+		return accept(handler_->startArray());
+	case Reader::tokenNumber:
+		return emitNumber() && endValue();
+	case Reader::tokenString:
+		return emitString() && endValue();
+	case Reader::tokenTrue:
+		return accept(handler_->boolean(true)) && endValue();
+	case Reader::tokenFalse:
+		return accept(handler_->boolean(false)) && endValue();
+	case Reader::tokenNull:
+		return accept(handler_->null()) && endValue();
+	case Reader::tokenArraySeparator:
+	case Reader::tokenObjectEnd:
+	case Reader::tokenArrayEnd:
+		// A missing value reads as null and the token is read again.
+		return accept(handler_->null()) && endValue() && readToken(type);
+	default:
+		return addError("Syntax error: value, object or array expected.");
+	}
+}
+
+/// Push a frame for a container, unless it nests past the stack limit.
+bool PushReader::openContainer(bool object) {
+	if (frames_.size() >= decoder_.stackLimit()) {
+		return addError("Exceeded the nesting limit of the reader.");
+	}
+	Frame frame;
+	frame.object_ = object;
+	frame.emptyName_ = true;
+	frames_.push_back(frame);
+	return true;
+}
+
+bool PushReader::readName(TokenType type) {
+	Frame& frame = frames_.back();
+	if (type == Reader::tokenObjectEnd && frame.emptyName_) {
+		return endContainer();
+	}
+	if (type == Reader::tokenString) {
+		name_.clear();
+		if (!decodeString(name_)) {
+			return false;
+		}
+	} else if (type == Reader::tokenNumber) {
+		Reader::Token token;
+		token.start_ = token_.data();
+		token.end_ = token_.data() + token_.length();
+		Value numberName;
+		if (!decoder_.decodeNumber(token, numberName)) {
+			return decodeError();
+		}
+		name_ = numberName.asString();
+	} else {
+		return addError("Missing '}' or object member name");
+	}
+	frame.emptyName_ = name_.empty();
+	expect_ = expectNameSeparator;
+	return true;
+}
+
+bool PushReader::endValue() {
+	if (frames_.empty()) {
+		lexer_ = lexDone;
+	} else if (frames_.back().object_) {
+		expect_ = expectMemberSeparator;
+	} else {
+		expect_ = expectElementSeparator;
+	}
+	return true;
+}
+
+bool PushReader::endContainer() {
+	bool object = frames_.back().object_;
+	frames_.pop_back();
+	return accept(object ? handler_->endObject() : handler_->endArray())
+			&& endValue();
+}
+
+bool PushReader::emitNumber() {
+	Reader::Token token;
+	token.start_ = token_.data();
+	token.end_ = token_.data() + token_.length();
+	Value decoded;
+	if (!decoder_.decodeNumber(token, decoded)) {
+		return decodeError();
+	}
+	switch (decoded.type()) {
+	case intValue:
+		return accept(handler_->int64(decoded.asInt64()));
+	case uintValue:
+		return accept(handler_->uint64(decoded.asUInt64()));
+	default:
+		return accept(handler_->real(decoded.asDouble()));
+	}
+}
+
+bool PushReader::emitString() {
+	// Nothing to unescape: hand out the buffered bytes as they are.
+	if (token_.find('\\') == std::string::npos) {
+		return accept(handler_->string(token_.data() + 1, token_.length() - 2));
+	}
+	decoded_.clear();
+	if (!decodeString(decoded_)) {
+		return false;
+	}
+	return accept(handler_->string(decoded_.data(), decoded_.length()));
+}
+
+bool PushReader::decodeString(std::string& decoded) {
+	Reader::Token token;
+	token.start_ = token_.data();
+	token.end_ = token_.data() + token_.length();
+	if (!decoder_.decodeString(token, decoded)) {
+		return decodeError();
+	}
+	return true;
+}
+
+bool PushReader::accept(bool accepted) {
+	if (accepted) {
+		return true;
+	}
+	return addError("Parsing stopped by the handler.");
+}
+
+/// Report the error the decoder recorded at the current token.
+bool PushReader::decodeError() {
+	std::string message = decoder_.errors_.back().message_;
+	decoder_.errors_.clear();
+	return addError(message);
+}
+
+bool PushReader::addError(const std::string& message) {
+	return addError(message, tokenLine_, tokenColumn_);
+}
+
+bool PushReader::addError(const std::string& message, int line, int column) {
+	error_ = message;
+	errorLine_ = line;
+	errorColumn_ = column;
+	failed_ = true;
+	return false;
+}
+
+std::string PushReader::getFormattedErrorMessages() const {
+	if (!failed_) {
+		return "";
+	}
+	char buffer[18 + 16 + 16 + 1];
+	snprintf(buffer, sizeof(buffer), "Line %d, Column %d", errorLine_,
+			errorColumn_);
+	return std::string("* ") + buffer + "\n  " + error_ + "\n";
+}
+
+std::vector<std::string> PushReader::getStructuredErrors() const {
+	std::vector<std::string> allErrors;
+	if (failed_) {
+		allErrors.push_back(error_);
+	}
+	return allErrors;
+}
+
+bool PushReader::good() const {
+	return !failed_;
+}
+
+} // namespace Json
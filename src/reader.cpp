@@ -6,18 +6,110 @@
  */
 
 #include "reader.h"
+#include "number.h"
+#include "object_table.h"
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef JSON_READER_STATS
+#define JSON_STAT(statement) statement
+#else
+#define JSON_STAT(statement)
+#endif
 
 namespace Json {
 
 // Implementation of class Reader
 // ////////////////////////////////
 
+// Class ReaderStats
+// //////////////////////////////////////////////////////////////////
+
+ReaderStats::ReaderStats() {
+	clear();
+}
+
+void ReaderStats::clear() {
+	objectBegins_ = objectEnds_ = arrayBegins_ = arrayEnds_ = 0;
+	strings_ = numbers_ = trues_ = falses_ = nulls_ = 0;
+	commas_ = colons_ = errors_ = 0;
+	stringBytes_ = numberBytes_ = literalBytes_ = whitespaceBytes_ = 0;
+	escapedStrings_ = integers_ = doubles_ = slowDoubles_ = 0;
+	containers_ = maxDepth_ = 0;
+}
+
+void ReaderStats::add(const ReaderStats& other) {
+	objectBegins_ += other.objectBegins_;
+	objectEnds_ += other.objectEnds_;
+	arrayBegins_ += other.arrayBegins_;
+	arrayEnds_ += other.arrayEnds_;
+	strings_ += other.strings_;
+	numbers_ += other.numbers_;
+	trues_ += other.trues_;
+	falses_ += other.falses_;
+	nulls_ += other.nulls_;
+	commas_ += other.commas_;
+	colons_ += other.colons_;
+	errors_ += other.errors_;
+	stringBytes_ += other.stringBytes_;
+	numberBytes_ += other.numberBytes_;
+	literalBytes_ += other.literalBytes_;
+	whitespaceBytes_ += other.whitespaceBytes_;
+	escapedStrings_ += other.escapedStrings_;
+	integers_ += other.integers_;
+	doubles_ += other.doubles_;
+	slowDoubles_ += other.slowDoubles_;
+	containers_ += other.containers_;
+	maxDepth_ = std::max(maxDepth_, other.maxDepth_);
+}
+
 // Class Reader
 // //////////////////////////////////////////////////////////////////
 
+/// Nesting accepted by default, as the stackLimit of jsoncpp.
+static const unsigned int defaultStackLimit = 1000;
+
+/// A container of the recycled tree that was created anew.
+static const size_t fresh = size_t(-1);
+
 Reader::Reader(int debug) :
 		begin_(NULL), end_(NULL), current_(NULL), lastValueEnd_(NULL), lastValue_(
-		NULL), debug(debug) {
+		NULL), indexCurrent_(NULL), indexEnd_(NULL), indexed_(false), arena_(
+		NULL), stackLimit_(defaultStackLimit), recycling_(false), keyTable_(
+		NULL), keyFilter_(NULL), strictUtf8_(false), debug(debug) {
+	frames_.reserve(32);
+}
+
+void Reader::setRecycling(bool recycling) {
+	recycling_ = recycling;
+}
+
+void Reader::setKeyTable(KeyTable* table) {
+	keyTable_ = table;
+}
+
+void Reader::setKeyFilter(const KeyFilter* filter) {
+	keyFilter_ = filter;
+}
+
+void Reader::setStrictUtf8(bool strict) {
+	strictUtf8_ = strict;
+}
+
+void Reader::setStackLimit(unsigned int limit) {
+	stackLimit_ = limit;
+}
+
+unsigned int Reader::stackLimit() const {
+	return stackLimit_;
+}
+
+const ReaderStats& Reader::stats() const {
+	return stats_;
 }
 
 bool Reader::parse(const std::string& document, Value& root) {
@@ -30,7 +122,360 @@ bool Reader::parse(const std::string& document, Value& root) {
 	return parse(begin, end, root);
 }
 
-bool Reader::parse(const char* beginDoc, const char* endDoc, Value& root) {
+bool Reader::parseFile(const std::string& path, Value& root) {
+	int fd = open(path.c_str(), O_RDONLY);
+	struct stat status;
+	if (fd < 0 || fstat(fd, &status) != 0) {
+		std::string message = "Cannot open " + path + ": " + strerror(errno);
+		if (fd >= 0) {
+			close(fd);
+		}
+		return fileError(message);
+	}
+
+	// Pipes and files of unknown size, like those of /proc, are read.
+	size_t length = size_t(status.st_size);
+	void* mapping = MAP_FAILED;
+	if (S_ISREG(status.st_mode) && length > 0) {
+		mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	if (mapping == MAP_FAILED) {
+		document_.clear();
+		char buffer[64 * 1024];
+		ssize_t count;
+		while ((count = read(fd, buffer, sizeof(buffer))) != 0) {
+			if (count < 0 && errno != EINTR) {
+				std::string message = "Cannot read " + path + ": "
+						+ strerror(errno);
+				close(fd);
+				return fileError(message);
+			}
+			if (count > 0) {
+				document_.append(buffer, count);
+			}
+		}
+		close(fd);
+		const char* begin = document_.data();
+		return parse(begin, begin + document_.length(), root);
+	}
+	close(fd);
+
+	// The document is read front to back, twice: once by the indexer, once
+	// by the parser. Huge pages only apply where the kernel supports them
+	// for file mappings; the hints are ignored otherwise.
+	madvise(mapping, length, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+	madvise(mapping, length, MADV_HUGEPAGE);
+#endif
+	const char* begin = static_cast<const char*>(mapping);
+	bool successful = parse(begin, begin + length, root);
+	if (!successful) {
+		// Error locations point into the mapping: move them to a copy.
+		document_.assign(begin, length);
+		rebase(begin, document_.data());
+	}
+	munmap(mapping, length);
+	return successful;
+}
+
+/// Report an error about the file itself, before any document is read.
+bool Reader::fileError(const std::string& message) {
+	document_.clear();
+	start(document_.data(), document_.data());
+	Token token;
+	token.type_ = tokenError;
+	token.start_ = begin_;
+	token.end_ = end_;
+	return addError(message, token);
+}
+
+/// Move the document, and the locations into it, from \c from to \c to.
+void Reader::rebase(Location from, Location to) {
+	for (Errors::iterator itError = errors_.begin(); itError != errors_.end();
+			++itError) {
+		Token& token = itError->token_;
+		if (token.start_ != NULL) {
+			token.start_ = to + (token.start_ - from);
+		}
+		if (token.end_ != NULL) {
+			token.end_ = to + (token.end_ - from);
+		}
+	}
+	end_ = to + (end_ - from);
+	current_ = to + (current_ - from);
+	begin_ = to;
+	// The index would read on in the old document.
+	indexed_ = false;
+	lastValueEnd_ = NULL;
+	lastValue_ = NULL;
+}
+
+bool Reader::parse(const std::string& document, Document& root) {
+	document_ = document;
+	const char* begin = document_.c_str();
+	const char* end = begin + document_.length();
+	return parse(begin, end, root);
+}
+
+bool Reader::parse(const char* beginDoc, const char* endDoc, Document& root) {
+	root.clear();
+	arena_ = &root.arena_;
+	bool successful = parse(beginDoc, endDoc, root.root_);
+	arena_ = NULL;
+	return successful;
+}
+
+bool Reader::parse(const std::string& document, const Selection& selection,
+		Value& root) {
+	document_ = document;
+	const char* begin = document_.c_str();
+	const char* end = begin + document_.length();
+	return parse(begin, end, selection, root);
+}
+
+bool Reader::parse(const std::string& document, Handler& handler) {
+	document_ = document;
+	const char* begin = document_.c_str();
+	const char* end = begin + document_.length();
+	return parse(begin, end, handler);
+}
+
+/** Builds the Value tree: every value is written to the node on top of
+ * nodes_, containers push a node per member or element.
+ */
+class Reader::ValueSink {
+public:
+	explicit ValueSink(Reader& reader) :
+			reader_(reader), recycling_(
+					reader.recycling_ && reader.arena_ == NULL) {
+	}
+
+	bool null(Token& token) {
+		reader_.currentValue() = Value();
+		return true;
+	}
+	bool boolean(bool value, Token& token) {
+		reader_.currentValue() = Value(value);
+		return true;
+	}
+	bool number(Token& token) {
+		return reader_.decodeNumber(token);
+	}
+	bool string(Token& token) {
+		return reader_.decodeString(token);
+	}
+
+	bool select(const std::string& name) {
+		return true;
+	}
+	bool select(ArrayIndex index) {
+		return true;
+	}
+
+	bool startObject(Token& token) {
+		if (recycling_) {
+			reader_.startRecycled(objectValue);
+			return true;
+		}
+		Value& object = reader_.currentValue();
+		object = Value(objectValue, reader_.arena_);
+		reader_.reserveMembers(object);
+		JSON_STAT(++reader_.stats_.containers_);
+		return true;
+	}
+	bool key(const std::string& name, Token& token) {
+		Value& object = reader_.currentValue();
+		Key key = reader_.keyTable_ != NULL ?
+				reader_.keyTable_->intern(name) :
+				Key::view(name.data(), name.length());
+		Value& value =
+				recycling_ && reader_.recycled_.back() != fresh ?
+						reader_.recycledMember(object, key) :
+						object.member(key);
+		reader_.nodes_.push_back(&value);
+		return true;
+	}
+	void endMember() {
+		reader_.nodes_.pop_back();
+	}
+	bool endObject(Token& token) {
+		if (recycling_) {
+			reader_.endRecycled();
+		}
+		reader_.countMembers(reader_.currentValue());
+		return true;
+	}
+
+	bool startArray(Token& token) {
+		if (recycling_) {
+			reader_.startRecycled(arrayValue);
+			return true;
+		}
+		reader_.currentValue() = Value(arrayValue, reader_.arena_);
+		JSON_STAT(++reader_.stats_.containers_);
+		return true;
+	}
+	bool element(ArrayIndex index) {
+		Value& value = reader_.currentValue()[index];
+		if (recycling_ && reader_.recycled_.back() != fresh) {
+			reader_.recycled_.back() = index + 1;
+		}
+		reader_.nodes_.push_back(&value);
+		return true;
+	}
+	void endElement() {
+		reader_.nodes_.pop_back();
+	}
+	bool endArray(Token& token) {
+		if (recycling_) {
+			reader_.endRecycled();
+		}
+		return true;
+	}
+
+private:
+	Reader& reader_;
+	bool recycling_;
+};
+
+/** Builds the parts of the Value tree a Selection asks for: members and
+ * elements it does not lead to are skipped by readObject() and readArray().
+ */
+class Reader::SelectSink: public ValueSink {
+public:
+	SelectSink(Reader& reader, const Selection& selection) :
+			ValueSink(reader), selection_(selection), selected_(0) {
+		path_.push_back(0);
+	}
+
+	bool select(const std::string& name) {
+		return select(selection_.whole(path_.back()) ?
+				path_.back() : selection_.child(path_.back(), name));
+	}
+	bool select(ArrayIndex index) {
+		return select(selection_.whole(path_.back()) ?
+				path_.back() : selection_.child(path_.back(), index));
+	}
+
+	bool key(const std::string& name, Token& token) {
+		path_.push_back(selected_);
+		return ValueSink::key(name, token);
+	}
+	void endMember() {
+		path_.pop_back();
+		ValueSink::endMember();
+	}
+	bool element(ArrayIndex index) {
+		path_.push_back(selected_);
+		return ValueSink::element(index);
+	}
+	void endElement() {
+		path_.pop_back();
+		ValueSink::endElement();
+	}
+
+private:
+	bool select(size_t node) {
+		selected_ = node;
+		return node != Selection::none;
+	}
+
+	const Selection& selection_;
+	/// The node of the selection for each enclosing container.
+	std::vector<size_t> path_;
+	size_t selected_;
+};
+
+/// Forwards every value to a Handler.
+class Reader::HandlerSink {
+public:
+	HandlerSink(Reader& reader, Handler& handler) :
+			reader_(reader), handler_(handler) {
+	}
+
+	bool null(Token& token) {
+		return accept(handler_.null(), token);
+	}
+	bool boolean(bool value, Token& token) {
+		return accept(handler_.boolean(value), token);
+	}
+	bool number(Token& token) {
+		Value decoded;
+		if (!reader_.decodeNumber(token, decoded)) {
+			return false;
+		}
+		switch (decoded.type()) {
+		case intValue:
+			return accept(handler_.int64(decoded.asInt64()), token);
+		case uintValue:
+			return accept(handler_.uint64(decoded.asUInt64()), token);
+		default:
+			return accept(handler_.real(decoded.asDouble()), token);
+		}
+	}
+	bool string(Token& token) {
+		Location begin = token.start_ + 1;
+		size_t length = token.end_ - token.start_ - 2;
+		// Nothing to unescape: hand out the document bytes as they are.
+		if (memchr(begin, '\\', length) == NULL) {
+			return accept(handler_.string(begin, length), token);
+		}
+		std::string& decoded = reader_.decoded_;
+		decoded.clear();
+		if (!reader_.decodeString(token, decoded)) {
+			return false;
+		}
+		return accept(handler_.string(decoded.data(), decoded.length()),
+				token);
+	}
+
+	bool select(const std::string& name) {
+		return true;
+	}
+	bool select(ArrayIndex index) {
+		return true;
+	}
+
+	bool startObject(Token& token) {
+		return accept(handler_.startObject(), token);
+	}
+	bool key(const std::string& name, Token& token) {
+		return accept(handler_.key(name.data(), name.length()), token);
+	}
+	void endMember() {
+	}
+	bool endObject(Token& token) {
+		return accept(handler_.endObject(), token);
+	}
+
+	bool startArray(Token& token) {
+		return accept(handler_.startArray(), token);
+	}
+	bool element(ArrayIndex index) {
+		return true;
+	}
+	void endElement() {
+	}
+	bool endArray(Token& token) {
+		return accept(handler_.endArray(), token);
+	}
+
+private:
+	bool accept(bool accepted, Token& token) {
+		if (accepted) {
+			return true;
+		}
+		reader_.addError("Parsing stopped by the handler.", token);
+		// Let the enclosing containers unwind without reading any further.
+		reader_.current_ = reader_.end_;
+		return false;
+	}
+
+	Reader& reader_;
+	Handler& handler_;
+};
+
+void Reader::start(Location beginDoc, Location endDoc) {
 	begin_ = beginDoc;
 	end_ = endDoc;
 
@@ -38,14 +483,41 @@ bool Reader::parse(const char* beginDoc, const char* endDoc, Value& root) {
 	lastValueEnd_ = 0;
 	lastValue_ = 0;
 
+	// Stage one: index the structural bytes of a first stretch; readToken()
+	// walks the index, which is refilled as it goes.
+	indexed_ = index_.build(begin_, end_, strictUtf8_);
+	indexCurrent_ = index_.begin();
+	indexEnd_ = index_.end();
+
 	errors_.clear();
-	while (!nodes_.empty()) {
-		nodes_.pop();
+	nodes_.clear();
+	recycled_.clear();
+	touched_.clear();
+	JSON_STAT(stats_.clear());
+}
+
+/// In strict mode, report the first invalid UTF-8 sequence of the document.
+bool Reader::checkUtf8() {
+	size_t offset = index_.invalidUtf8();
+	if (offset == StructuralIndex::npos) {
+		return true;
 	}
+	Token token;
+	token.type_ = tokenError;
+	token.start_ = begin_ + offset;
+	token.end_ = token.start_ + 1;
+	return addError("Invalid UTF-8 sequence.", token);
+}
 
-	nodes_.push(&root);
+bool Reader::parse(const char* beginDoc, const char* endDoc, Value& root) {
+	start(beginDoc, endDoc);
+	if (!checkUtf8()) {
+		return false;
+	}
+	nodes_.push_back(&root);
 
-	bool successful = readValue();
+	ValueSink sink(*this);
+	bool successful = readValue(sink);
 	Token token;
 
 	if (successful && !root.isArray() && !root.isObject()) {
@@ -64,64 +536,264 @@ bool Reader::parse(const char* beginDoc, const char* endDoc, Value& root) {
 	return successful;
 }
 
-bool Reader::readValue() {
+bool Reader::parse(const char* beginDoc, const char* endDoc,
+		Handler& handler) {
+	start(beginDoc, endDoc);
+	if (!checkUtf8()) {
+		return false;
+	}
 
-	Token token;
-	bool successful = true;
+	// A scalar root must not produce any event: let the Value overload
+	// report the same errors for it.
+	skipSpaces();
+	if (current_ == end_ || (*current_ != '{' && *current_ != '[')) {
+		Value root;
+		return parse(beginDoc, endDoc, root);
+	}
 
-	readToken(token);
+	HandlerSink sink(*this, handler);
+	return readValue(sink);
+}
 
-	switch (token.type_) {
-	case tokenObjectBegin: {
-		successful = readObject();
-		break;
-	}
-	case tokenArrayBegin: {
-		successful = readArray();
-		break;
-	}
-	case tokenNumber: {
-		successful = decodeNumber(token);
-		break;
-	}
-	case tokenString: {
-		successful = decodeString(token);
-		break;
+bool Reader::parse(const char* beginDoc, const char* endDoc,
+		const Selection& selection, Value& root) {
+	if (selection.whole(0)) {
+		return parse(beginDoc, endDoc, root);
 	}
-	case tokenTrue: {
-		Value v(true);
-		currentValue().swap(v);
-		break;
-	}
-	case tokenFalse: {
-		Value v(false);
-		currentValue().swap(v);
-		break;
-	}
-	case tokenNull: {
-		Value v;
-		currentValue().swap(v);
-		break;
-	}
-	case tokenArraySeparator:
-	case tokenObjectEnd:
-	case tokenArrayEnd: {
-		// "Un-read" the current token and mark the current value as a null
-		// token.
-		current_--;
-		Value v;
-		currentValue().swap(v);
-		break;
+	start(beginDoc, endDoc);
+	if (!checkUtf8()) {
+		return false;
 	}
-	default: {
-		return addError("Syntax error: value, object or array expected.", token);
+	nodes_.push_back(&root);
+
+	SelectSink sink(*this, selection);
+	bool successful = readValue(sink);
+	if (successful && !root.isArray() && !root.isObject()) {
+		// Let the full parse report a scalar root.
+		return parse(beginDoc, endDoc, root);
 	}
+	return successful;
+}
+
+/** Read the next value, the whole tree below it included.
+ *
+ * The nesting is followed with frames_, an explicit stack of the open
+ * containers, instead of recursing: the native stack used does not depend
+ * on the document, and nesting deeper than stackLimit_ is an error.
+ * After an error every open container recovers, innermost first, as the
+ * recursive readObject() and readArray() did.
+ */
+template<typename Sink>
+bool Reader::readValue(Sink& sink) {
+	enum Step {
+		stepValue, stepName, stepElement, stepNext
+	};
+
+	frames_.clear();
+	std::string& name = name_;
+	Token token;
+	Step step = stepValue;
+
+	for (;;) {
+		switch (step) {
+		case stepValue: {
+			readToken(token);
+			bool ok = true;
+			switch (token.type_) {
+			case tokenObjectBegin:
+			case tokenArrayBegin: {
+				if (frames_.size() >= stackLimit_) {
+					addError("Exceeded the nesting limit of the reader.", token);
+					return recoverNested();
+				}
+				bool object = token.type_ == tokenObjectBegin;
+				if (!(object ? sink.startObject(token) : sink.startArray(token))) {
+					return recoverNested();
+				}
+				Frame frame;
+				frame.object_ = object;
+				frame.built_ = false;
+				frame.emptyName_ = true;
+				frame.index_ = 0;
+				frames_.push_back(frame);
+				JSON_STAT(stats_.maxDepth_ = std::max(stats_.maxDepth_,
+						UInt64(frames_.size())));
+				if (object) {
+					step = stepName;
+					continue;
+				}
+				skipSpaces();
+				if (current_ != end_ && *current_ == ']') {		// empty array
+					Token endArray;
+					readToken(endArray);
+					frames_.pop_back();
+					if (!sink.endArray(endArray)) {
+						return recoverNested();
+					}
+					step = stepNext;
+					continue;
+				}
+				step = stepElement;
+				continue;
+			}
+			case tokenNumber:
+				ok = sink.number(token);
+				break;
+			case tokenString:
+				ok = sink.string(token);
+				break;
+			case tokenTrue:
+				ok = sink.boolean(true, token);
+				break;
+			case tokenFalse:
+				ok = sink.boolean(false, token);
+				break;
+			case tokenNull:
+				ok = sink.null(token);
+				break;
+			case tokenArraySeparator:
+			case tokenObjectEnd:
+			case tokenArrayEnd:
+				// "Un-read" the current token and mark the current value as a
+				// null token.
+				current_--;
+				ok = sink.null(token);
+				break;
+			default:
+				addError("Syntax error: value, object or array expected.", token);
+				return recoverNested();
+			}
+			if (!ok) {
+				return recoverNested();
+			}
+			step = stepNext;
+			continue;
+		}
+
+		case stepName: {
+			Frame& frame = frames_.back();
+			Token tokenName;
+			readToken(tokenName);
+			// empty object, or a trailing ',' after an empty name
+			if (tokenName.type_ == tokenObjectEnd && frame.emptyName_) {
+				frames_.pop_back();
+				if (!sink.endObject(tokenName)) {
+					return recoverNested();
+				}
+				step = stepNext;
+				continue;
+			}
+
+			name.clear();
+			if (tokenName.type_ == tokenString) {
+				if (!decodeString(tokenName, name)) {
+					return recoverNested();
+				}
+			} else if (tokenName.type_ == tokenNumber) {
+				Value numberName;
+				if (!decodeNumber(tokenName, numberName)) {
+					return recoverNested();
+				}
+				name = numberName.asString();
+			} else {
+				addError("Missing '}' or object member name", tokenName);
+				return recoverNested();
+			}
+			frame.emptyName_ = name.empty();
+
+			Token colon;
+			if (!readToken(colon) || colon.type_ != tokenMemberSeparator) {
+				addError("Missing ':' after object member name", colon);
+				return recoverNested();
+			}
+			frame.built_ = (keyFilter_ == NULL || keyFilter_->keep(name))
+					&& sink.select(name);
+			if (!frame.built_) {
+				if (!skipUnselected()) {
+					return recoverNested();
+				}
+				step = stepNext;
+				continue;
+			}
+			if (!sink.key(name, tokenName)) {
+				frames_.pop_back();
+				return recoverNested();
+			}
+			step = stepValue;
+			continue;
+		}
+
+		case stepElement: {
+			Frame& frame = frames_.back();
+			frame.built_ = sink.select(frame.index_);
+			if (!frame.built_) {
+				++frame.index_;
+				if (!skipUnselected()) {
+					return recoverNested();
+				}
+				step = stepNext;
+				continue;
+			}
+			if (!sink.element(frame.index_++)) {
+				frames_.pop_back();
+				return recoverNested();
+			}
+			step = stepValue;
+			continue;
+		}
+
+		case stepNext: {
+			// A value is complete: go on with its container, if any.
+			if (frames_.empty()) {
+				return true;
+			}
+			Frame& frame = frames_.back();
+			if (frame.built_) {
+				if (frame.object_) {
+					sink.endMember();
+				} else {
+					sink.endElement();
+				}
+			}
+
+			Token separator;
+			readToken(separator);
+			TokenType endType = frame.object_ ? tokenObjectEnd : tokenArrayEnd;
+			if (separator.type_ == tokenArraySeparator) {
+				step = frame.object_ ? stepName : stepElement;
+				continue;
+			}
+			if (separator.type_ != endType) {
+				addError(
+						frame.object_ ?
+								"Missing ',' or '}' in object declaration" :
+								"Missing ',' or ']' in array declaration",
+						separator);
+				return recoverNested();
+			}
+			bool object = frame.object_;
+			frames_.pop_back();
+			if (!(object ? sink.endObject(separator) : sink.endArray(separator))) {
+				return recoverNested();
+			}
+			step = stepNext;
+			continue;
+		}
+		}
 	}
+}
 
-	return successful;
+/// Let every open container skip to its end after an error.
+bool Reader::recoverNested() {
+	while (!frames_.empty()) {
+		recoverFromError(frames_.back().object_ ? tokenObjectEnd : tokenArrayEnd);
+		frames_.pop_back();
+	}
+	return false;
 }
 
 bool Reader::readToken(Token& token) {
+	JSON_STAT(Location spaces = current_);
 	skipSpaces();
 
 	token.start_ = current_;
@@ -186,13 +858,77 @@ bool Reader::readToken(Token& token) {
 	}
 	if (!ok) {
 		token.type_ = tokenError;
+		// The bytes were not consumed the way the index assumes, so its
+		// string ranges can no longer be trusted for this document.
+		indexed_ = false;
 	}
 
 	token.end_ = current_;
+	JSON_STAT(countToken(token, spaces));
 	return true;
 }
 
+/// Account for a token read, and the whitespace before it from \c spaces.
+void Reader::countToken(const Token& token, Location spaces) {
+	stats_.whitespaceBytes_ += UInt64(token.start_ - spaces);
+	UInt64 length = UInt64(token.end_ - token.start_);
+	switch (token.type_) {
+	case tokenObjectBegin:
+		++stats_.objectBegins_;
+		break;
+	case tokenObjectEnd:
+		++stats_.objectEnds_;
+		break;
+	case tokenArrayBegin:
+		++stats_.arrayBegins_;
+		break;
+	case tokenArrayEnd:
+		++stats_.arrayEnds_;
+		break;
+	case tokenString:
+		++stats_.strings_;
+		stats_.stringBytes_ += length;
+		break;
+	case tokenNumber:
+		++stats_.numbers_;
+		stats_.numberBytes_ += length;
+		break;
+	case tokenTrue:
+		++stats_.trues_;
+		stats_.literalBytes_ += length;
+		break;
+	case tokenFalse:
+		++stats_.falses_;
+		stats_.literalBytes_ += length;
+		break;
+	case tokenNull:
+		++stats_.nulls_;
+		stats_.literalBytes_ += length;
+		break;
+	case tokenArraySeparator:
+		++stats_.commas_;
+		break;
+	case tokenMemberSeparator:
+		++stats_.colons_;
+		break;
+	case tokenError:
+		++stats_.errors_;
+		break;
+	default:
+		break;
+	}
+}
+
 void Reader::skipSpaces() {
+	if (indexed_) {
+		// The first byte after a whitespace run is always indexed.
+		if (current_ != end_
+				&& (*current_ == ' ' || *current_ == '\t' || *current_ == '\r'
+						|| *current_ == '\n')) {
+			current_ = seekIndex(current_);
+		}
+		return;
+	}
 	while (current_ != end_) {
 		Char c = *current_;
 		if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
@@ -218,36 +954,58 @@ bool Reader::match(Location pattern, int patternLength) {
 	return true;
 }
 
+/// Find the end of the number whose first char was just read. It is only
+/// converted by decodeNumber(), if a value is wanted.
 void Reader::readNumber() {
-	if (!(current_ < end_)) {
-		return;
-	}
-
-// integral part
-	while (current_ < end_ && *current_ >= '0' && *current_ <= '9') {
-		current_ = current_ + 1;
-	}
+	current_ = skipNumber(current_ - 1, end_);
+}
 
-// fractional part
-	if (current_ < end_ && *current_ == '.') {
-		current_ = current_ + 1;
-		while (current_ < end_ && *current_ >= '0' && *current_ <= '9') {
-			current_ = current_ + 1;
-		}
-	}
-// exponential part
-	if (current_ < end_ && (*current_ == 'e' || *current_ == 'E')) {
-		current_ = current_ + 1;
-		if (current_ < end_ && (*current_ == '+' || *current_ == '-')) {
-			current_ = current_ + 1;
+Reader::Location Reader::seekIndex(Location location) {
+	StructuralIndex::Offset offset = StructuralIndex::Offset(location - begin_);
+	do {
+		while (indexCurrent_ != indexEnd_ && *indexCurrent_ < offset) {
+			++indexCurrent_;
 		}
-		while (current_ < end_ && *current_ >= '0' && *current_ <= '9') {
-			current_ = current_ + 1;
+	} while (indexCurrent_ == indexEnd_ && refillIndex());
+	return indexCurrent_ == indexEnd_ ? end_ : begin_ + *indexCurrent_;
+}
+
+/// Step to the next entry of the index. \return \c false at the end of
+/// the document.
+bool Reader::nextIndexEntry() {
+	return ++indexCurrent_ != indexEnd_ || refillIndex();
+}
+
+/// Index the stretch of the document after the end of the window.
+/// \return \c false at the end of the document.
+bool Reader::refillIndex() {
+	const StructuralIndex::Offset* added;
+	while ((added = index_.next()) != NULL) {
+		indexCurrent_ = added;
+		indexEnd_ = index_.end();
+		if (indexCurrent_ != indexEnd_) {
+			return true;
 		}
 	}
+	return false;
 }
 
 bool Reader::readString() {
+	if (indexed_) {
+		// Strings hold no index entries: the entry after the opening quote
+		// is the closing one.
+		Location open = current_ - 1;
+		if (seekIndex(open) == open) {
+			if (!nextIndexEntry()) {
+				current_ = end_;
+				return false;
+			}
+			current_ = begin_ + *indexCurrent_ + 1;
+			return true;
+		}
+		indexed_ = false;
+	}
+
 	Char c = 0;
 	while (current_ != end_) {
 		c = getNextChar();
@@ -260,100 +1018,458 @@ bool Reader::readString() {
 	return c == '"';
 }
 
-bool Reader::readObject() {
+/// Move the tokenizer to \c location, backwards as well as forwards.
+void Reader::seek(Location location) {
+	current_ = location;
+	if (!indexed_) {
+		return;
+	}
+	StructuralIndex::Offset offset = StructuralIndex::Offset(location - begin_);
+	if (offset < index_.windowBegin()) {
+		// Behind the window: index again from there.
+		index_.restart(offset);
+		indexCurrent_ = index_.begin();
+		indexEnd_ = index_.end();
+		return;
+	}
+	if (offset >= index_.windowEnd()) {
+		indexCurrent_ = indexEnd_;
+		seekIndex(location);
+		return;
+	}
+	const StructuralIndex::Offset* first = index_.begin();
+	const StructuralIndex::Offset* last = indexEnd_;
+	// Seeks mostly move a little way from the last position.
+	if (indexCurrent_ != indexEnd_ && *indexCurrent_ < offset) {
+		first = indexCurrent_;
+		for (int i = 0; i < 8 && first != last && *first < offset; ++i) {
+			++first;
+		}
+	} else if (indexCurrent_ != index_.begin()) {
+		last = indexCurrent_;
+		if (last[-1] < offset) {
+			return;
+		}
+	}
+	indexCurrent_ = std::lower_bound(first, last, offset);
+}
+
+/** Skip the next value by bracket and quote matching only: nothing in it
+ * is decoded or checked. A missing value, before ',', '}' or ']', is left
+ * alone as readValue() would read it as null.
+ * \return \c false if the document ends before the value does.
+ */
+bool Reader::skipValue() {
+	skipSpaces();
+	if (current_ == end_) {
+		return false;
+	}
+	Char c = *current_;
+	if (c == ',' || c == '}' || c == ']') {
+		return true;
+	}
+	if (c != '{' && c != '[') {
+		Token token;
+		readToken(token);
+		return token.type_ != tokenError && token.type_ != tokenEndOfStream;
+	}
 
-	Token tokenName;
-	std::string name = "";
-	Value init(objectValue);
-	currentValue().swap(init);
+	int depth = 0;
+	if (indexed_) {
+		seekIndex(current_);
+		for (bool more = indexCurrent_ != indexEnd_; more;
+				more = nextIndexEntry()) {
+			switch (begin_[*indexCurrent_]) {
+			case '"':
+				// Strings hold no entries: the next one is the closing quote.
+				if (!nextIndexEntry()) {
+					current_ = end_;
+					return false;
+				}
+				break;
+			case '{':
+			case '[':
+				++depth;
+				break;
+			case '}':
+			case ']':
+				if (--depth == 0) {
+					current_ = begin_ + *indexCurrent_++ + 1;
+					return true;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+		current_ = end_;
+		return false;
+	}
 
-	while (readToken(tokenName)) {
-		// empty object
-		if (tokenName.type_ == tokenObjectEnd && name.empty()) {
+	bool inString = false;
+	while (current_ != end_) {
+		c = *current_++;
+		if (inString) {
+			if (c == '\\') {
+				if (current_ == end_) {
+					return false;
+				}
+				++current_;
+			} else if (c == '"') {
+				inString = false;
+			}
+		} else if (c == '"') {
+			inString = true;
+		} else if (c == '{' || c == '[') {
+			++depth;
+		} else if ((c == '}' || c == ']') && --depth == 0) {
 			return true;
 		}
+	}
+	return false;
+}
+
+/// Skip a value nobody asked for, reporting a document that ends in it.
+bool Reader::skipUnselected() {
+	skipSpaces();
+	Token token;
+	token.type_ = tokenError;
+	token.start_ = current_;
+	if (skipValue()) {
+		return true;
+	}
+	token.end_ = current_;
+	return addError("Syntax error: value, object or array expected.", token);
+}
 
-		name = "";
-		if (tokenName.type_ == tokenString) {
-			if (!decodeString(tokenName, name)) {
-				return recoverFromError(tokenObjectEnd);
+/// Read the value at \c location into \c decoded, as parse() would.
+bool Reader::decodeValue(Location location, Value& decoded) {
+	seek(location);
+	errors_.clear();
+	nodes_.clear();
+	recycled_.clear();
+	touched_.clear();
+	nodes_.push_back(&decoded);
+	ValueSink sink(*this);
+	bool ok = readValue(sink);
+	nodes_.pop_back();
+	return ok;
+}
+
+/// Give a new object room for as many members as the last object ended at
+/// its depth: records of one shape then allocate their members once.
+void Reader::reserveMembers(Value& object) {
+#ifndef JSON_MAP_OBJECTS
+	size_t depth = nodes_.size();
+	if (depth < memberCounts_.size()) {
+		object.value_.map_->reserve(memberCounts_[depth]);
+	}
+#endif
+}
+
+/// Remember the size of the object just read, for reserveMembers().
+void Reader::countMembers(const Value& object) {
+	size_t depth = nodes_.size();
+	if (depth >= memberCounts_.size()) {
+		memberCounts_.resize(depth + 1);
+	}
+	memberCounts_[depth] = object.size();
+}
+
+/// Reuse the current value as a container of \c type, see setRecycling().
+void Reader::startRecycled(ValueType type) {
+	Value& current = currentValue();
+	if (current.type_ != type) {
+		current = Value(type);
+		recycled_.push_back(fresh);
+		JSON_STAT(++stats_.containers_);
+	} else if (type == objectValue) {
+		recycled_.push_back(touched_.size());
+	} else {
+		recycled_.push_back(0);
+	}
+}
+
+/// The member \c key of a recycled object, recorded for endRecycled().
+Value& Reader::recycledMember(Value& object, const Key& key) {
+#ifdef JSON_MAP_OBJECTS
+	Value& value = object.member(key);
+	touched_.push_back(&value);
+	return value;
+#else
+	// Claimed members move to the front of the order, see endRecycled().
+	return object.value_.map_->claim(key, recycled_.back());
+#endif
+}
+
+/// Drop what the previous document left in the container just read.
+void Reader::endRecycled() {
+	size_t first = recycled_.back();
+	recycled_.pop_back();
+	if (first == fresh) {
+		return;
+	}
+	Value& container = currentValue();
+	if (container.type_ == arrayValue) {
+		if (first < container.size()) {
+			container.resize(ArrayIndex(first));
+		}
+		return;
+	}
+
+#ifdef JSON_MAP_OBJECTS
+	// Members may repeat: only the distinct ones are kept.
+	Value::ObjectValues& members = *container.value_.map_;
+	std::vector<Value*>::iterator begin = touched_.begin() + first;
+	std::sort(begin, touched_.end());
+	std::vector<Value*>::iterator end = std::unique(begin, touched_.end());
+	if (members.size() != size_t(end - begin)) {
+		for (Value::ObjectValues::iterator it = members.begin();
+				it != members.end();) {
+			if (std::binary_search(begin, end, &it->second)) {
+				++it;
+			} else {
+				members.erase(it++);
 			}
-		} else if (tokenName.type_ == tokenNumber) {
-			Value numberName;
-			if (!decodeNumber(tokenName, numberName))
-				return recoverFromError(tokenObjectEnd);
-			name = numberName.asString();
-		} else {
-			break;
 		}
+	}
+	touched_.resize(first);
+#else
+	container.value_.map_->truncate(first);
+#endif
+}
 
-		Token colon;
-		if (!readToken(colon) || colon.type_ != tokenMemberSeparator) {
-			return addErrorAndRecover("Missing ':' after object member name",
-					colon, tokenObjectEnd);
-		}
-		Value& value = currentValue()[name];
-		nodes_.push(&value);
-		bool ok = readValue();
-		nodes_.pop();
-		if (!ok) {		// error already set
-			return recoverFromError(tokenObjectEnd);
-		}
-
-		Token comma;
-		if (!readToken(comma)
-				|| (comma.type_ != tokenObjectEnd
-						&& comma.type_ != tokenArraySeparator
-						&& comma.type_ != tokenComment)) {
-			return addErrorAndRecover(
-					"Missing ',' or '}' in object declaration", comma,
-					tokenObjectEnd);
-		}
-		bool finalizeTokenOk = true;
-		while (comma.type_ == tokenComment && finalizeTokenOk)
-			finalizeTokenOk = readToken(comma);
-		if (comma.type_ == tokenObjectEnd)
-			return true;
+/// The elements of a top-level array and the runs of them threads parse.
+class Reader::ArraySlices {
+public:
+	/// After the '[' and at the closing ']'.
+	Location begin_;
+	Location end_;
+	/// The commas between elements.
+	std::vector<Location> separators_;
+	/// First element of each run, then the element count.
+	std::vector<size_t> runs_;
+	Value* values_;
+	/// The nesting the elements may have, one less than the document.
+	unsigned int stackLimit_;
+	/// Options of the reader the elements are read as by.
+	KeyTable* keyTable_;
+	const KeyFilter* keyFilter_;
+	/// Where the threads add up their counts, under mutex_.
+	ReaderStats* stats_;
+	size_t next_;
+	bool failed_;
+	pthread_mutex_t mutex_;
+
+	size_t size() const {
+		return separators_.size() + 1;
+	}
+	Location elementBegin(size_t index) const {
+		return index == 0 ? begin_ : separators_[index - 1] + 1;
+	}
+	Location elementEnd(size_t index) const {
+		return index == separators_.size() ? end_ : separators_[index];
+	}
+};
+
+bool Reader::parseParallel(const char* beginDoc, const char* endDoc,
+		Value& root, int threads) {
+	if (threads <= 0) {
+		long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = cpus > 0 ? int(cpus) : 1;
+	}
+	start(beginDoc, endDoc);
+
+	ArraySlices slices;
+	if (threads == 1 || stackLimit_ == 0
+			|| index_.invalidUtf8() != StructuralIndex::npos
+			|| !splitArray(slices)) {
+		return parse(beginDoc, endDoc, root);
+	}
+
+	// Runs of about the same size, several per thread to balance the load.
+	size_t runBytes = size_t(slices.end_ - slices.begin_) / (threads * 8) + 1;
+	Location runBegin = slices.begin_;
+	for (size_t index = 0; index < slices.size(); ++index) {
+		if (index == 0 || slices.elementBegin(index) - runBegin >= ptrdiff_t(runBytes)) {
+			slices.runs_.push_back(index);
+			runBegin = slices.elementBegin(index);
+		}
+	}
+	slices.runs_.push_back(slices.size());
+
+	// The elements are read straight into their slot of the root array.
+	Value array(arrayValue);
+	array.resize(ArrayIndex(slices.size()));
+	slices.values_ = &array[ArrayIndex(0)];
+	slices.stackLimit_ = stackLimit_ - 1;
+	slices.keyTable_ = keyTable_;
+	slices.keyFilter_ = keyFilter_;
+	slices.stats_ = &stats_;
+	slices.next_ = 0;
+	slices.failed_ = false;
+	pthread_mutex_init(&slices.mutex_, NULL);
+
+	std::vector<pthread_t> workers;
+	threads = int(std::min(size_t(threads), slices.runs_.size() - 1));
+	for (int i = 1; i < threads; ++i) {
+		pthread_t worker;
+		if (pthread_create(&worker, NULL, readSlices, &slices) == 0) {
+			workers.push_back(worker);
+		}
+	}
+	readSlices(&slices);
+	for (size_t i = 0; i < workers.size(); ++i) {
+		pthread_join(workers[i], NULL);
+	}
+	pthread_mutex_destroy(&slices.mutex_);
+
+	if (slices.failed_) {
+		return parse(beginDoc, endDoc, root);
 	}
-	return addErrorAndRecover("Missing '}' or object member name", tokenName,
-			tokenObjectEnd);
+	// The root array itself and the commas between runs, which the
+	// threads do not read.
+	JSON_STAT(stats_.commas_ += slices.runs_.size() - 2);
+	JSON_STAT(++stats_.arrayBegins_);
+	JSON_STAT(++stats_.arrayEnds_);
+	JSON_STAT(++stats_.containers_);
+	root = std::move(array);
+	return true;
 }
 
-bool Reader::readArray() {
-	Value init(arrayValue);
-	currentValue().swap(init);
-	skipSpaces();
+/// Follow the nesting by one structural byte, see splitArray().
+static bool nestArray(Reader::Location at, std::vector<char>& closing,
+		std::vector<Reader::Location>& separators, Reader::Location& end) {
+	char c = *at;
+	switch (c) {
+	case '[':
+		closing.push_back(']');
+		break;
+	case '{':
+		closing.push_back('}');
+		break;
+	case ']':
+	case '}':
+		if (closing.empty() || closing.back() != c) {
+			return false;
+		}
+		closing.pop_back();
+		if (closing.empty()) {
+			end = at;
+		}
+		break;
+	case ',':
+		if (closing.size() == 1) {
+			separators.push_back(at);
+		}
+		break;
+	default:
+		break;
+	}
+	return true;
+}
 
-	if (*current_ == ']') {		// empty array
-		Token endArray;
-		readToken(endArray);
-		return true;
+/** Find the elements of a root array, with the structural index or, for
+ * documents too large to index, a scan of the bytes.
+ * \return \c false if the root is not an array, is not well nested or
+ * has a single element.
+ */
+bool Reader::splitArray(ArraySlices& slices) {
+	skipSpaces();
+	if (current_ == end_ || *current_ != '[') {
+		return false;
+	}
+	slices.begin_ = current_ + 1;
+	slices.end_ = NULL;
+	std::vector<Char> closing;
+
+	if (indexed_) {
+		for (bool more = indexCurrent_ != indexEnd_ || refillIndex();
+				more && slices.end_ == NULL; more = nextIndexEntry()) {
+			Location at = begin_ + *indexCurrent_;
+			if (*at == '"') {
+				// Strings hold no entries: the next one is the closing quote.
+				if (!nextIndexEntry()) {
+					return false;
+				}
+			} else if (!nestArray(at, closing, slices.separators_, slices.end_)) {
+				return false;
+			}
+		}
+	} else {
+		bool inString = false;
+		for (Location at = current_; at != end_ && slices.end_ == NULL; ++at) {
+			if (inString) {
+				if (*at == '\\') {
+					if (++at == end_) {
+						return false;
+					}
+				} else if (*at == '"') {
+					inString = false;
+				}
+			} else if (*at == '"') {
+				inString = true;
+			} else if (!nestArray(at, closing, slices.separators_, slices.end_)) {
+				return false;
+			}
+		}
 	}
-	int index = 0;
+	return slices.end_ != NULL && !slices.separators_.empty();
+}
+
+void* Reader::readSlices(void* data) {
+	ArraySlices& slices = *static_cast<ArraySlices*>(data);
+	Reader reader;
+	reader.setStackLimit(slices.stackLimit_);
+	reader.setKeyTable(slices.keyTable_);
+	reader.setKeyFilter(slices.keyFilter_);
 	for (;;) {
-		Value& value = currentValue()[index++];
-		nodes_.push(&value);
-		bool ok = readValue();
-		nodes_.pop();
-		if (!ok) // error already set
-			return recoverFromError(tokenArrayEnd);
+		pthread_mutex_lock(&slices.mutex_);
+		size_t run = slices.next_++;
+		bool failed = slices.failed_;
+		pthread_mutex_unlock(&slices.mutex_);
+		if (failed || run + 1 >= slices.runs_.size()) {
+			return NULL;
+		}
+		bool ok = reader.readElements(slices, slices.runs_[run],
+				slices.runs_[run + 1]);
+#ifdef JSON_READER_STATS
+		// The elements are nested in the root array.
+		++reader.stats_.maxDepth_;
+		pthread_mutex_lock(&slices.mutex_);
+		slices.stats_->add(reader.stats_);
+		pthread_mutex_unlock(&slices.mutex_);
+#endif
+		if (!ok) {
+			pthread_mutex_lock(&slices.mutex_);
+			slices.failed_ = true;
+			pthread_mutex_unlock(&slices.mutex_);
+		}
+	}
+}
 
-		Token token;
-		// Accept Comment after last item in the array.
-		ok = readToken(token);
-		while (token.type_ == tokenComment && ok) {
-			ok = readToken(token);
-		}
-		bool badTokenType = (token.type_ != tokenArraySeparator
-				&& token.type_ != tokenArrayEnd);
-		if (!ok || badTokenType) {
-			return addErrorAndRecover("Missing ',' or ']' in array declaration",
-					token, tokenArrayEnd);
-		}
-		if (token.type_ == tokenArrayEnd)
-			break;
+/// Read elements [first, last) the way readArray() does.
+bool Reader::readElements(ArraySlices& slices, size_t first, size_t last) {
+	start(slices.elementBegin(first), slices.elementEnd(last - 1));
+	ValueSink sink(*this);
+	for (size_t index = first; index != last; ++index) {
+		nodes_.push_back(&slices.values_[index]);
+		bool ok = readValue(sink);
+		nodes_.pop_back();
+		if (!ok) {
+			return false;
+		}
+		if (index + 1 != last) {
+			Token comma;
+			readToken(comma);
+			if (comma.type_ != tokenArraySeparator
+					|| comma.start_ != slices.separators_[index]) {
+				return false;
+			}
+		}
 	}
-	return true;
+	skipSpaces();
+	return current_ == end_;
 }
 
 bool Reader::decodeNumber(Token& token) {
@@ -362,49 +1478,45 @@ bool Reader::decodeNumber(Token& token) {
 		return false;
 	}
 
-	currentValue().swap(decoded);
+	currentValue() = std::move(decoded);
 	return true;
 }
 
 bool Reader::decodeNumber(Token& token, Value& decoded) {
-// Attempts to parse the number as an integer. If the number is
-// larger than the maximum supported value of an integer then
-// we decode the number as a double.
-	Location current = token.start_;
-	bool isNegative = *current == '-';
-	if (isNegative) {
-		++current;
-	}
-
-// TODO: Help the compiler do the div and mod at compile time or get rid of them.
-	Value::LargestUInt maxIntegerValue = Value::maxLargestUInt;
-	if (isNegative) {
-		maxIntegerValue = Value::LargestUInt(-Value::minLargestInt);
-	}
-
-	Value::LargestUInt threshold = maxIntegerValue / 10;
-	Value::LargestUInt value = 0;
-	while (current < token.end_) {
-		Char c = *current++;
-		if (c < '0' || c > '9') {
-			return decodeDouble(token, decoded);
-		}
-		Value::UInt digit(c - '0');
-		if (value >= threshold) {
-			if (value > threshold || current != token.end_
-					|| digit > maxIntegerValue % 10) {
-				return decodeDouble(token, decoded);
+// Decodes the number as an integer if it is one and fits, as a double
+// otherwise, splitting the token in one pass.
+	NumberParts number;
+	scanNumber(token.start_, token.end_, number);
+
+	if (number.integral_) {
+		Value::LargestUInt value = number.integer_;
+		if (number.negative_) {
+			if (value <= Value::LargestUInt(-Value::minLargestInt)) {
+				decoded = -Value::LargestInt(value);
+				JSON_STAT(++stats_.integers_);
+				return true;
+			}
+		} else {
+			if (value <= Value::LargestUInt(Value::maxInt)) {
+				decoded = Value::LargestInt(value);
+			} else {
+				decoded = value;
 			}
+			JSON_STAT(++stats_.integers_);
+			return true;
 		}
-		value = value * 10 + digit;
 	}
-	if (isNegative) {
-		decoded = -Value::LargestInt(value);
-	} else if (value <= Value::LargestUInt(Value::maxInt)) {
-		decoded = Value::LargestInt(value);
-	} else {
-		decoded = value;
+
+	double value = 0;
+	bool slowPath = false;
+	if (!convertDouble(number, value, &slowPath)) {
+		return addError(
+				"'" + std::string(token.start_, token.end_)
+						+ "' is not a number.", token);
 	}
+	JSON_STAT(++stats_.doubles_);
+	JSON_STAT(stats_.slowDoubles_ += slowPath ? 1 : 0);
+	decoded = value;
 	return true;
 }
 
@@ -413,39 +1525,13 @@ bool Reader::decodeDouble(Token& token) {
 	if (!decodeDouble(token, decoded)) {
 		return false;
 	}
-	currentValue().swap(decoded);
+	currentValue() = std::move(decoded);
 	return true;
 }
 
 bool Reader::decodeDouble(Token& token, Value& decoded) {
 	double value = 0;
-	const int bufferSize = 32;
-	int count;
-	int length = int(token.end_ - token.start_);
-
-// Sanity check to avoid buffer overflow exploits.
-	if (length < 0) {
-		return addError("Unable to parse token length", token);
-	}
-
-// Avoid using a string constant for the format control string given to
-// sscanf, as this can cause hard to debug crashes on OS X. See here for more
-// info:
-//
-//     http://developer.apple.com/library/mac/#DOCUMENTATION/DeveloperTools/gcc-4.0.1/gcc/Incompatibilities.html
-	char format[] = "%lf";
-
-	if (length <= bufferSize) {
-		Char buffer[bufferSize + 1];
-		memcpy(buffer, token.start_, length);
-		buffer[length] = 0;
-		count = sscanf(buffer, format, &value);
-	} else {
-		std::string buffer(token.start_, token.end_);
-		count = sscanf(buffer.c_str(), format, &value);
-	}
-
-	if (count != 1) {
+	if (!parseDouble(token.start_, token.end_, value)) {
 		return addError(
 				"'" + std::string(token.start_, token.end_)
 						+ "' is not a number.", token);
@@ -455,13 +1541,18 @@ bool Reader::decodeDouble(Token& token, Value& decoded) {
 }
 
 bool Reader::decodeString(Token& token) {
-	std::string decoded_string;
-	if (!decodeString(token, decoded_string)) {
+	decoded_.clear();
+	if (!decodeString(token, decoded_)) {
 		return false;
 	}
 
-	Value decoded(decoded_string);
-	currentValue().swap(decoded);
+	Value& current = currentValue();
+	if (recycling_ && current.type_ == stringValue && arena_ == NULL) {
+		current.assignString(decoded_.data(), decoded_.length());
+		return true;
+	}
+	current = Value(decoded_.data(), decoded_.data() + decoded_.length(),
+			arena_);
 	return true;
 }
 
@@ -469,11 +1560,14 @@ bool Reader::decodeString(Token& token, std::string& decoded) {
 	decoded.reserve(token.end_ - token.start_ - 2);
 	Location current = token.start_ + 1; // skip '"'
 	Location end = token.end_ - 1; // do not include '"'
+	JSON_STAT(bool escaped = false);
 	while (current != end) {
 		Char c = *current++;
 		if (c == '"') {
 			break;
 		} else if (c == '\\') {
+			JSON_STAT(stats_.escapedStrings_ += escaped ? 0 : 1);
+			JSON_STAT(escaped = true);
 			if (current == end) {
 				return addError("Empty escape sequence in string", token);
 			}
@@ -607,7 +1701,7 @@ bool Reader::addErrorAndRecover(const std::string& message, Token& token,
 }
 
 Value & Reader::currentValue() {
-	return *(nodes_.top());
+	return *nodes_.back();
 }
 
 Reader::Char Reader::getNextChar() {
@@ -625,7 +1719,7 @@ void Reader::getLocationLineAndColumn(Location location, int& line,
 	while (current < location && current != end_) {
 		Char c = *current++;
 		if (c == '\r') {
-			if (*current == '\n') {
+			if (current != end_ && *current == '\n') {
 				++current;
 			}
 			lastLineStart = current;
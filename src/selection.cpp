@@ -0,0 +1,174 @@
+/*
+ * selection.cpp
+ *
+ *  Created on: 2026-10-17
+ */
+
+#include "selection.h"
+
+namespace Json {
+
+// Class Selection
+// //////////////////////////////////////////////////////////////////
+
+Selection::Selection() :
+		nodes_(1) {
+}
+
+Selection::Selection(const std::vector<std::string>& paths) :
+		nodes_(1) {
+	for (size_t i = 0; i < paths.size(); ++i) {
+		add(paths[i]);
+	}
+}
+
+bool Selection::add(const std::string& path) {
+	std::vector<std::string> segments;
+	for (size_t i = 0; i < path.length(); ++i) {
+		char c = path[i];
+		if (c == '/') {
+			segments.push_back(std::string());
+		} else if (segments.empty()) {
+			return false;
+		} else if (c != '~') {
+			segments.back() += c;
+		} else if (i + 1 < path.length()
+				&& (path[i + 1] == '0' || path[i + 1] == '1')) {
+			segments.back() += path[++i] == '0' ? '~' : '/';
+		} else {
+			return false;
+		}
+	}
+	insert(0, segments, 0);
+	return true;
+}
+
+void Selection::clear() {
+	nodes_.assign(1, Node());
+}
+
+bool Selection::empty() const {
+	return nodes_.size() == 1 && !nodes_[0].whole_;
+}
+
+size_t Selection::addNode() {
+	nodes_.push_back(Node());
+	return nodes_.size() - 1;
+}
+
+size_t Selection::copyNode(size_t node) {
+	size_t copy = addNode();
+	nodes_[copy].whole_ = nodes_[node].whole_;
+	if (nodes_[node].any_ != none) {
+		size_t any = copyNode(nodes_[node].any_);
+		nodes_[copy].any_ = any;
+	}
+	// addNode() may move the nodes: copy the names first.
+	Children children = nodes_[node].children_;
+	for (Children::iterator it = children.begin(); it != children.end();
+			++it) {
+		size_t child = copyNode(it->second);
+		nodes_[copy].children_[it->first] = child;
+	}
+	return copy;
+}
+
+/** Add the path \c segments from \c first on below \c node.
+ *
+ * A name and "*" at the same place must both apply to that name: "*" paths
+ * are also added below every named child, and a new named child starts as a
+ * copy of what "*" already leads to.
+ */
+void Selection::insert(size_t node, const std::vector<std::string>& segments,
+		size_t first) {
+	if (first == segments.size()) {
+		nodes_[node].whole_ = true;
+		return;
+	}
+	const std::string& segment = segments[first];
+	if (segment == "*") {
+		if (nodes_[node].any_ == none) {
+			size_t any = addNode();
+			nodes_[node].any_ = any;
+		}
+		insert(nodes_[node].any_, segments, first + 1);
+		std::vector<size_t> named;
+		for (Children::iterator it = nodes_[node].children_.begin();
+				it != nodes_[node].children_.end(); ++it) {
+			named.push_back(it->second);
+		}
+		for (size_t i = 0; i < named.size(); ++i) {
+			insert(named[i], segments, first + 1);
+		}
+		return;
+	}
+
+	Children::iterator it = nodes_[node].children_.find(segment);
+	size_t child;
+	if (it != nodes_[node].children_.end()) {
+		child = it->second;
+	} else {
+		child = nodes_[node].any_ == none ? addNode() : copyNode(nodes_[node].any_);
+		nodes_[node].children_[segment] = child;
+	}
+	insert(child, segments, first + 1);
+}
+
+size_t Selection::child(size_t node, const std::string& name) const {
+	const Node& parent = nodes_[node];
+	if (!parent.children_.empty()) {
+		Children::const_iterator it = parent.children_.find(name);
+		if (it != parent.children_.end()) {
+			return it->second;
+		}
+	}
+	return parent.any_;
+}
+
+size_t Selection::child(size_t node, ArrayIndex index) const {
+	const Node& parent = nodes_[node];
+	if (!parent.children_.empty()) {
+		char name[16];
+		snprintf(name, sizeof(name), "%u", index);
+		Children::const_iterator it = parent.children_.find(name);
+		if (it != parent.children_.end()) {
+			return it->second;
+		}
+	}
+	return parent.any_;
+}
+
+bool Selection::whole(size_t node) const {
+	return nodes_[node].whole_;
+}
+
+// Class KeyFilter
+// //////////////////////////////////////////////////////////////////
+
+KeyFilter::KeyFilter() {
+}
+
+KeyFilter::~KeyFilter() {
+}
+
+void KeyFilter::deny(const std::string& name) {
+	denied_.insert(name);
+}
+
+void KeyFilter::allow(const std::string& name) {
+	allowed_.insert(name);
+}
+
+void KeyFilter::clear() {
+	denied_.clear();
+	allowed_.clear();
+}
+
+bool KeyFilter::keep(const std::string& name) const {
+	if (!denied_.empty() && denied_.count(name) != 0) {
+		return false;
+	}
+	return allowed_.empty() || allowed_.count(name) != 0;
+}
+
+} // namespace Json
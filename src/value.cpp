@@ -6,6 +6,7 @@
  */
 
 #include "value.h"
+#include "object_table.h"
 #include "writer.h"
 
 namespace Json {
@@ -22,6 +23,9 @@ const unsigned char& kNullRef = kNull[0];
 const Value& Value::null = reinterpret_cast<const Value&>(kNullRef);
 const Value& Value::nullRef = null;
 
+// Short strings fill the Value up to its type: keep it at two words.
+static_assert(sizeof(Value) == 16, "Value must be 16 bytes");
+
 const Int Value::minInt = Int(~(UInt(-1) / 2));
 const Int Value::maxInt = Int(UInt(-1) / 2);
 const UInt Value::maxUInt = UInt(-1);
@@ -101,8 +105,19 @@ void throwLogicError(std::string const& msg) {
 // //////////////////////////////////////////////////////////////////
 // //////////////////////////////////////////////////////////////////
 
-void Value::initBasic(ValueType type) {
+/// Construct a T in \c arena, or on the heap if it is NULL.
+template<typename T>
+static inline T* allocatePayload(Arena* arena) {
+	if (arena == NULL) {
+		return new T();
+	}
+	void* memory = arena->allocate(sizeof(T), alignof(T));
+	return new (memory) T(typename T::allocator_type(arena));
+}
+
+void Value::initBasic(ValueType type, Arena* arena) {
 	type_ = type;
+	shortLength_ = 0;
 
 	switch (type) {
 	case nullValue:
@@ -118,21 +133,66 @@ void Value::initBasic(ValueType type) {
 		value_.bool_ = false;
 		break;
 	case stringValue:
-		value_.string_ = new StringValues();
+		// An empty short string: nothing to allocate yet.
 		break;
 	case arrayValue:
-		value_.array_ = new ArrayValues();
+		value_.array_ = allocatePayload<ArrayValues>(arena);
 		break;
 	case objectValue:
-		value_.map_ = new ObjectValues();
+		value_.map_ = allocatePayload<ObjectValues>(arena);
 		break;
 	default:
 		JSON_ASSERT_UNREACHABLE;
 	}
 }
 
-Value::StringValues* Value::getStringVaule() {
-	return (Value::StringValues*) (value_.string_);
+/// Whether the payload belongs to the Arena of a Document.
+bool Value::inArena() const {
+	switch (type_) {
+	case stringValue:
+		return !isShortString()
+				&& value_.string_->get_allocator().arena() != NULL;
+	case arrayValue:
+		return value_.array_->get_allocator().arena() != NULL;
+	case objectValue:
+		return value_.map_->get_allocator().arena() != NULL;
+	default:
+		return false;
+	}
+}
+
+const char* Value::stringData() const {
+	return isShortString() ? shortString() : value_.string_->data();
+}
+
+size_t Value::stringLength() const {
+	return isShortString() ? shortLength_ : value_.string_->length();
+}
+
+void Value::assignString(const char* data, size_t length, Arena* arena) {
+	if (length <= shortLength) {
+		releaseString();
+		memmove(shortString(), data, length);
+		shortLength_ = (unsigned char) length;
+		return;
+	}
+	if (isShortString()) {
+		value_.string_ = allocatePayload<StringValues>(arena);
+		shortLength_ = longString;
+	}
+	value_.string_->assign(data, length);
+}
+
+/// Free a long string, leaving an empty short one.
+void Value::releaseString() {
+	if (isShortString()) {
+		shortLength_ = 0;
+		return;
+	}
+	if (value_.string_->get_allocator().arena() == NULL) {
+		delete value_.string_;
+	}
+	shortLength_ = 0;
 }
 Value::ObjectValues* Value::getObjectVaule() {
 	return (Value::ObjectValues*) (value_.map_);
@@ -184,12 +244,21 @@ Value::Value(bool value) {
 
 Value::Value(const char* value) {
 	initBasic(stringValue);
-	(*value_.string_) = value;
+	assignString(value, strlen(value));
 }
 
 Value::Value(const std::string& value) {
 	initBasic(stringValue);
-	(*value_.string_) = value;
+	assignString(value.data(), value.length());
+}
+
+Value::Value(ValueType type, Arena* arena) {
+	initBasic(type, arena);
+}
+
+Value::Value(const char* begin, const char* end, Arena* arena) {
+	initBasic(stringValue);
+	assignString(begin, end - begin, arena);
 }
 
 Value& Value::assignment(Value const& other) {
@@ -202,7 +271,7 @@ Value& Value::assignment(Value const& other) {
 		value_ = other.value_;
 		break;
 	case stringValue:
-		(*value_.string_) = (*other.value_.string_);
+		assignString(other.stringData(), other.stringLength());
 		break;
 	case arrayValue:
 		(*value_.array_) = (*other.value_.array_);
@@ -218,11 +287,23 @@ Value& Value::assignment(Value const& other) {
 }
 
 Value::Value(Value const& other) {
-	initBasic(other.type_);
+	initBasic(ValueType(other.type_));
 	assignment(other);
 }
 
+Value::Value(Value&& other) noexcept {
+	value_ = other.value_;
+	memcpy(shortTail_, other.shortTail_, sizeof(shortTail_));
+	shortLength_ = other.shortLength_;
+	type_ = other.type_;
+	other.initBasic(nullValue);
+}
+
 void Value::destructor() {
+	// The arena releases its payloads all at once.
+	if (inArena()) {
+		return;
+	}
 	switch (type_) {
 	case nullValue:
 	case intValue:
@@ -231,10 +312,7 @@ void Value::destructor() {
 	case booleanValue:
 		break;
 	case stringValue:
-		if (value_.string_ != NULL) {
-			delete value_.string_;
-			value_.string_ = NULL;
-		}
+		releaseString();
 		break;
 	case arrayValue:
 		if (value_.array_ != NULL) {
@@ -260,19 +338,28 @@ Value::~Value() {
 void Value::swap(Value& other) {
 	std::swap(type_, other.type_);
 	std::swap(value_, other.value_);
+	std::swap(shortTail_, other.shortTail_);
+	std::swap(shortLength_, other.shortLength_);
 }
 
 Value& Value::operator=(const Value& other) {
 	if (type_ != other.type_) {
 		destructor();
-		initBasic(other.type_);
+		initBasic(ValueType(other.type_));
 	}
 	assignment(other);
 	return *this;
 }
 
+Value& Value::operator=(Value&& other) noexcept {
+	// Take other out first: it may be part of the tree this one frees.
+	Value taken(std::move(other));
+	swap(taken);
+	return *this;
+}
+
 ValueType Value::type() const {
-	return type_;
+	return ValueType(type_);
 }
 
 int Value::compare(const Value& other) const {
@@ -302,8 +389,13 @@ bool Value::operator<(const Value& other) const {
 		return value_.real_ < other.value_.real_;
 	case booleanValue:
 		return value_.bool_ < other.value_.bool_;
-	case stringValue:
-		return (*value_.string_) < (*other.value_.string_);
+	case stringValue: {
+		size_t length = stringLength();
+		size_t otherLength = other.stringLength();
+		int diff = memcmp(stringData(), other.stringData(),
+				std::min(length, otherLength));
+		return diff != 0 ? diff < 0 : length < otherLength;
+	}
 	case arrayValue:
 		return (*value_.array_) < (*other.value_.array_);
 	case objectValue:
@@ -327,7 +419,17 @@ bool Value::operator>(const Value& other) const {
 }
 
 bool Value::operator==(const Value& other) const {
-	return !(*this < other || *this > other);
+	if (type_ != other.type_) {
+		return false;
+	}
+	switch (type_) {
+	case arrayValue:
+		return (*value_.array_) == (*other.value_.array_);
+	case objectValue:
+		return (*value_.map_) == (*other.value_.map_);
+	default:
+		return !(*this < other || *this > other);
+	}
 }
 
 bool Value::operator!=(const Value& other) const {
@@ -443,7 +545,7 @@ std::string Value::asString() const {
 	case nullValue:
 		return "";
 	case stringValue:
-		return *value_.string_;
+		return std::string(stringData(), stringLength());
 	case booleanValue:
 		return value_.bool_ ? "true" : "false";
 	case intValue:
@@ -665,7 +767,7 @@ ArrayIndex Value::size() const {
 	case realValue:
 	case booleanValue:
 	case stringValue:
-		return ArrayIndex(value_.string_->length());
+		return ArrayIndex(stringLength());
 	case arrayValue:
 		return ArrayIndex(value_.array_->size());
 	case objectValue:
@@ -707,6 +809,7 @@ void Value::clear() {
 
 void Value::resize(ArrayIndex newSize) {
 	transformType(arrayValue);
+	// Growing moves the elements, the move constructor being noexcept.
 	getArrayVaule()->resize(newSize);
 }
 
@@ -728,9 +831,16 @@ const Value& Value::operator[](int index) const {
 	return (*this)[ArrayIndex(index)];
 }
 
-void Value::append(const Value& value) {
+Value& Value::append(const Value& value) {
+	// Copy first: value may be an element of this array.
+	return append(Value(value));
+}
+
+Value& Value::append(Value&& value) {
 	transformType(arrayValue);
-	getArrayVaule()->push_back(value);
+	ArrayValues& array = *getArrayVaule();
+	array.push_back(std::move(value));
+	return array.back();
 }
 
 void Value::removeIndex(ArrayIndex index) {
@@ -741,69 +851,124 @@ void Value::removeIndex(ArrayIndex index) {
 	value_.array_->erase(value_.array_->begin() + index);
 }
 
-Value * Value::find(const char* key) {
+Value * Value::find(const char* begin, const char* end) {
 	transformType(objectValue);
-	ObjectValues::iterator it = value_.map_->find(key);
+	ObjectValues::iterator it = value_.map_->find(
+			Key::view(begin, end - begin));
 	if (it == value_.map_->end()) {
 		return NULL;
 	}
 	return &(it->second);
 }
+Value * Value::find(const char* key) {
+	return find(key, key + strlen(key));
+}
 Value * Value::find(const std::string& key) {
-	return find(key.c_str());
+	return find(key.data(), key.data() + key.length());
 }
 
-const Value * Value::find(const char* key) const {
+const Value * Value::find(const char* begin, const char* end) const {
 	if (objectValue != type_) {
 		return NULL;
 	}
-	ObjectValues::iterator it = value_.map_->find(key);
+	ObjectValues::iterator it = value_.map_->find(
+			Key::view(begin, end - begin));
 	if (it == value_.map_->end()) {
 		return NULL;
 	}
 	return &(it->second);
 }
-
+const Value * Value::find(const char* key) const {
+	return find(key, key + strlen(key));
+}
 const Value * Value::find(const std::string& key) const {
-	return find(key.c_str());
-
+	return find(key.data(), key.data() + key.length());
 }
 
-Value& Value::operator[](const char*key) {
+Value& Value::findOrInsert(const char* begin, const char* end,
+		bool* inserted) {
 	transformType(objectValue);
-	if (find(key) == NULL) {
-		(*value_.map_)[key] = Value();
+	return member(Key::view(begin, end - begin), inserted);
+}
+
+/// The member named \c key of an object, added if missing.
+Value& Value::member(const Key& key, bool* inserted) {
+#ifdef JSON_MAP_OBJECTS
+	ObjectValues& map = *value_.map_;
+	ObjectValues::iterator it = map.lower_bound(key);
+	bool missing = it == map.end() || key < it->first;
+	if (missing) {
+		// The key is allocated like the map, arena included.
+		it = map.emplace_hint(it, std::piecewise_construct,
+				std::forward_as_tuple(key, map.get_allocator().arena()),
+				std::forward_as_tuple());
+	}
+	if (inserted != NULL) {
+		*inserted = missing;
 	}
-	return *find(key);
+	return it->second;
+#else
+	std::pair<ObjectValues::iterator, bool> result = value_.map_->try_emplace(
+			key);
+	if (inserted != NULL) {
+		*inserted = result.second;
+	}
+	return result.first->second;
+#endif
+}
+
+Value& Value::operator[](const char* key) {
+	return findOrInsert(key, key + strlen(key));
 }
 Value& Value::operator[](const std::string& key) {
-	return (*this)[key.c_str()];
+	return findOrInsert(key.data(), key.data() + key.length());
 }
 
 const Value& Value::operator[](const char* key) const {
-	if (find(key) == NULL) {
-		(*value_.map_)[key] = Value();
+	const Value* value = find(key);
+	if (value == NULL) {
+		return null;
 	}
-	return *find(key);
+	return *value;
 }
 const Value& Value::operator[](const string& key) const {
-	return (*this)[key.c_str()];
+	const Value* value = find(key);
+	if (value == NULL) {
+		return null;
+	}
+	return *value;
+}
+
+Value Value::get(const char* begin, const char* end,
+		const Value& defaultValue) const {
+	const Value* value = find(begin, end);
+	return value == NULL ? defaultValue : *value;
+}
+Value Value::get(const char* key, const Value& defaultValue) const {
+	return get(key, key + strlen(key), defaultValue);
+}
+Value Value::get(const std::string& key, const Value& defaultValue) const {
+	return get(key.data(), key.data() + key.length(), defaultValue);
 }
 
 void Value::removeMember(std::string const& key) {
 	transformType(objectValue);
-	ObjectValues::iterator it = value_.map_->find(key);
+	ObjectValues::iterator it = value_.map_->find(
+			Key::view(key.data(), key.length()));
 	if (it == value_.map_->end()) {
 		return;
 	}
 	value_.map_->erase(it);
 }
 
+bool Value::isMember(const char* begin, const char* end) const {
+	return find(begin, end) != NULL;
+}
+bool Value::isMember(const char* key) const {
+	return find(key) != NULL;
+}
 bool Value::isMember(string const& key) const {
-	if (type_ != objectValue) {
-		return false;
-	}
-	return NULL != find(key);
+	return find(key) != NULL;
 }
 
 Value::Members Value::getMemberNames() const {
@@ -812,9 +977,9 @@ Value::Members Value::getMemberNames() const {
 		return members;
 	}
 	int size = value_.map_->size();
-	for (map<string, Value>::iterator it = value_.map_->begin();
+	for (ObjectValues::iterator it = value_.map_->begin();
 			it != value_.map_->end() && size; it++, size--) {
-		members.push_back(std::string(it->first));
+		members.push_back(std::string(it->first.data(), it->first.length()));
 	}
 
 	return members;
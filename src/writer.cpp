@@ -76,7 +76,8 @@ std::string FastWriter::write(const Value& root) {
 		document_ += "\n";
 	}
 
-	return document_;
+	// The document is handed over, not copied.
+	return std::move(document_);
 }
 
 void FastWriter::writeValue(const Value& value) {